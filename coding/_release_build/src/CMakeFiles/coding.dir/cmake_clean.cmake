@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/coding.dir/main.cpp.o"
+  "CMakeFiles/coding.dir/main.cpp.o.d"
+  "coding"
+  "coding.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/coding.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
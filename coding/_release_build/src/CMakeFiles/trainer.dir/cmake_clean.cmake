@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trainer.dir/trainer.cpp.o"
+  "CMakeFiles/trainer.dir/trainer.cpp.o.d"
+  "trainer"
+  "trainer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/trainer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
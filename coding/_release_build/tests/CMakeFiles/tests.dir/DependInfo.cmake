@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/coding/src/coders/LZ77Coder.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/LZ77Coder.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/LZ77Coder.cpp.o.d"
+  "/root/repo/coding/src/coders/LZWCoder.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/LZWCoder.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/LZWCoder.cpp.o.d"
+  "/root/repo/coding/src/coders/ShannonFanoCoder.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/ShannonFanoCoder.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/ShannonFanoCoder.cpp.o.d"
+  "/root/repo/coding/src/coders/lz77/BinaryTreeMatchFinder.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/BinaryTreeMatchFinder.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/BinaryTreeMatchFinder.cpp.o.d"
+  "/root/repo/coding/src/coders/lz77/BruteForceMatchFinder.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/BruteForceMatchFinder.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/BruteForceMatchFinder.cpp.o.d"
+  "/root/repo/coding/src/coders/lz77/HashChainMatchFinder.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/HashChainMatchFinder.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/HashChainMatchFinder.cpp.o.d"
+  "/root/repo/coding/src/coders/lz77/LongDistanceMatchFinder.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/LongDistanceMatchFinder.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/LongDistanceMatchFinder.cpp.o.d"
+  "/root/repo/coding/src/coders/lz77/MatchLength.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/MatchLength.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/MatchLength.cpp.o.d"
+  "/root/repo/coding/src/coders/lz77/PriceModel.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/PriceModel.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/PriceModel.cpp.o.d"
+  "/root/repo/coding/src/coders/lz77/WideCopy.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/WideCopy.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lz77/WideCopy.cpp.o.d"
+  "/root/repo/coding/src/coders/lzw/HashDictionary.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lzw/HashDictionary.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lzw/HashDictionary.cpp.o.d"
+  "/root/repo/coding/src/coders/lzw/WordTable.cpp" "tests/CMakeFiles/tests.dir/__/src/coders/lzw/WordTable.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/coders/lzw/WordTable.cpp.o.d"
+  "/root/repo/coding/src/common/BitReader.cpp" "tests/CMakeFiles/tests.dir/__/src/common/BitReader.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/common/BitReader.cpp.o.d"
+  "/root/repo/coding/src/common/BitWriter.cpp" "tests/CMakeFiles/tests.dir/__/src/common/BitWriter.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/common/BitWriter.cpp.o.d"
+  "/root/repo/coding/src/common/DictionaryTrainer.cpp" "tests/CMakeFiles/tests.dir/__/src/common/DictionaryTrainer.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/common/DictionaryTrainer.cpp.o.d"
+  "/root/repo/coding/src/common/Packer.cpp" "tests/CMakeFiles/tests.dir/__/src/common/Packer.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/common/Packer.cpp.o.d"
+  "/root/repo/coding/src/common/ThreadPool.cpp" "tests/CMakeFiles/tests.dir/__/src/common/ThreadPool.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/common/ThreadPool.cpp.o.d"
+  "/root/repo/coding/src/common/Unpacker.cpp" "tests/CMakeFiles/tests.dir/__/src/common/Unpacker.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/__/src/common/Unpacker.cpp.o.d"
+  "/root/repo/coding/tests/coders_test.cpp" "tests/CMakeFiles/tests.dir/coders_test.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/coders_test.cpp.o.d"
+  "/root/repo/coding/tests/gtest/gtest-all.cc" "tests/CMakeFiles/tests.dir/gtest/gtest-all.cc.o" "gcc" "tests/CMakeFiles/tests.dir/gtest/gtest-all.cc.o.d"
+  "/root/repo/coding/tests/gtest/gtest_main.cc" "tests/CMakeFiles/tests.dir/gtest/gtest_main.cc.o" "gcc" "tests/CMakeFiles/tests.dir/gtest/gtest_main.cc.o.d"
+  "/root/repo/coding/tests/packing_test.cpp" "tests/CMakeFiles/tests.dir/packing_test.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/packing_test.cpp.o.d"
+  "/root/repo/coding/tests/special_tests.cpp" "tests/CMakeFiles/tests.dir/special_tests.cpp.o" "gcc" "tests/CMakeFiles/tests.dir/special_tests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
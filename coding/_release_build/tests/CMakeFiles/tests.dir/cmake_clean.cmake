@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests.dir/__/src/coders/LZ77Coder.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/LZ77Coder.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/LZWCoder.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/LZWCoder.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/ShannonFanoCoder.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/ShannonFanoCoder.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/BinaryTreeMatchFinder.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/BinaryTreeMatchFinder.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/BruteForceMatchFinder.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/BruteForceMatchFinder.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/HashChainMatchFinder.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/HashChainMatchFinder.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/LongDistanceMatchFinder.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/LongDistanceMatchFinder.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/MatchLength.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/MatchLength.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/PriceModel.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/PriceModel.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/WideCopy.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lz77/WideCopy.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lzw/HashDictionary.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lzw/HashDictionary.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/coders/lzw/WordTable.cpp.o"
+  "CMakeFiles/tests.dir/__/src/coders/lzw/WordTable.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/common/BitReader.cpp.o"
+  "CMakeFiles/tests.dir/__/src/common/BitReader.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/common/BitWriter.cpp.o"
+  "CMakeFiles/tests.dir/__/src/common/BitWriter.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/common/DictionaryTrainer.cpp.o"
+  "CMakeFiles/tests.dir/__/src/common/DictionaryTrainer.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/common/Packer.cpp.o"
+  "CMakeFiles/tests.dir/__/src/common/Packer.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/common/ThreadPool.cpp.o"
+  "CMakeFiles/tests.dir/__/src/common/ThreadPool.cpp.o.d"
+  "CMakeFiles/tests.dir/__/src/common/Unpacker.cpp.o"
+  "CMakeFiles/tests.dir/__/src/common/Unpacker.cpp.o.d"
+  "CMakeFiles/tests.dir/coders_test.cpp.o"
+  "CMakeFiles/tests.dir/coders_test.cpp.o.d"
+  "CMakeFiles/tests.dir/gtest/gtest-all.cc.o"
+  "CMakeFiles/tests.dir/gtest/gtest-all.cc.o.d"
+  "CMakeFiles/tests.dir/gtest/gtest_main.cc.o"
+  "CMakeFiles/tests.dir/gtest/gtest_main.cc.o.d"
+  "CMakeFiles/tests.dir/packing_test.cpp.o"
+  "CMakeFiles/tests.dir/packing_test.cpp.o.d"
+  "CMakeFiles/tests.dir/special_tests.cpp.o"
+  "CMakeFiles/tests.dir/special_tests.cpp.o.d"
+  "tests"
+  "tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -1,5 +1,13 @@
 #include <vector>
+#include <cassert>
 #include <memory>
+#include <deque>
+#include <istream>
+#include <ostream>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
 
 #ifndef COMMON_DECLARATIONS
 #define COMMON_DECLARATIONS
@@ -8,6 +16,31 @@
 
 #endif
 
+#ifndef LZ77_MATCH_FINDERS
+#define LZ77_MATCH_FINDERS
+
+#include "lz77/BruteForceMatchFinder.cpp"
+#include "lz77/HashChainMatchFinder.cpp"
+#include "lz77/BinaryTreeMatchFinder.cpp"
+#include "lz77/LongDistanceMatchFinder.cpp"
+#include "lz77/WideCopy.cpp"
+
+#endif
+
+#ifndef THREAD_POOL
+#define THREAD_POOL
+
+#include "../common/ThreadPool.cpp"
+
+#endif
+
+#ifndef LZ77_PRICE_MODEL
+#define LZ77_PRICE_MODEL
+
+#include "lz77/PriceModel.cpp"
+
+#endif
+
 /**
 Class which provides methods for coding/encoding data with LZ77 algorithm.
 */
@@ -17,9 +50,10 @@ public:
     /**
     * `Triple` struct contains offset, which is calculated from the right to the left, 
     * length of an equal part and the first one chracter, which is different.
+    * Offsets of long-distance matches are not bounded by the dictionary, so they are 64-bit.
     */
     struct Triple {
-        int offset;
+        long long offset;
         int length;
         char character;
 
@@ -29,95 +63,532 @@ public:
             this->character = '0';
         }
 
-        Triple(int offset, int length, char character) {
+        Triple(long long offset, int length, char character) {
             this->offset = offset;
             this->length = length;
             this->character = character;
         }
     };
 
+    /**
+    * Compact sequence of triples. Characters are stored in their own array, and offsets and lengths are stored
+    * only for triples with matches, which are marked in a bit vector. The number of matches before each word
+    * of the bit vector is stored too, so a triple can be accessed by its index in constant time.
+    * A triple takes a bit more than one byte, if it is a single character, and thirteen bytes otherwise,
+    * instead of sixteen bytes of `Triple`.
+    */
+    class TripleBuffer {
+
+    public:
+        /**
+        * Iterator, which returns triples by value.
+        */
+        class Iterator {
+        public:
+            Iterator(const TripleBuffer& buffer, size_t index, size_t matchIndex):
+                    buffer(buffer), index(index), matchIndex(matchIndex) {}
+
+            Triple operator*() const {
+                if (!buffer.hasMatch(index))
+                    return Triple(0, 0, buffer.characters[index]);
+
+                return Triple(buffer.offsets[matchIndex], buffer.lengths[matchIndex], buffer.characters[index]);
+            }
+
+            Iterator& operator++() {
+                if (buffer.hasMatch(index))
+                    matchIndex++;
+                index++;
+
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return index != other.index;
+            }
+
+        private:
+            const TripleBuffer& buffer;
+            size_t index;
+            size_t matchIndex;
+        };
+
+        TripleBuffer() {}
+
+        explicit TripleBuffer(const std::vector<Triple>& triples) {
+            for (const Triple& triple: triples)
+                push_back(triple);
+        }
+
+        void push_back(const Triple& triple) {
+            size_t index = characters.size();
+            if (index % 64 == 0) {
+                flags.push_back(0);
+                ranks.push_back(lengths.size());
+            }
+
+            characters.push_back(triple.character);
+            if (triple.length > 0) {
+                flags.back() |= 1ULL << (index % 64);
+                offsets.push_back(triple.offset);
+                lengths.push_back(triple.length);
+            }
+        }
+
+        Triple operator[](size_t index) const {
+            return *Iterator(*this, index, matchesBefore(index));
+        }
+
+        size_t size() const {
+            return characters.size();
+        }
+
+        bool empty() const {
+            return characters.empty();
+        }
+
+        void clear() {
+            characters.clear();
+            flags.clear();
+            ranks.clear();
+            offsets.clear();
+            lengths.clear();
+        }
+
+        Iterator begin() const {
+            return Iterator(*this, 0, 0);
+        }
+
+        Iterator end() const {
+            return Iterator(*this, size(), lengths.size());
+        }
+
+    private:
+        /// Deques grow by blocks, so the buffer does not need twice more memory, when it grows.
+        std::deque<char> characters;
+
+        /* Bit `i % 64` of word `i / 64` is set, if triple `i` has a match. */
+        std::vector<uint64_t> flags;
+
+        /* Number of matches before each word of `flags`. */
+        std::vector<uint64_t> ranks;
+
+        /// Offsets and lengths of matches are kept apart, so they are not padded to 16 bytes together.
+        std::deque<long long> offsets;
+        std::deque<int> lengths;
+
+
+        bool hasMatch(size_t index) const {
+            return (flags[index / 64] >> (index % 64)) & 1;
+        }
+
+
+        size_t matchesBefore(size_t index) const {
+            uint64_t previousFlags = flags[index / 64] & ((1ULL << (index % 64)) - 1);
+            return ranks[index / 64] + __builtin_popcountll(previousFlags);
+        }
+    };
+
+    /**
+    * `Block` struct contains number of characters of a part of data, which is coded separately, and its triples.
+    */
+    struct Block {
+        int size;
+        TripleBuffer triples;
+
+        Block() {
+            this->size = 0;
+        }
+
+        Block(int size, const TripleBuffer& triples) {
+            this->size = size;
+            this->triples = triples;
+        }
+    };
+
+    /**
+    * Strategies of searching for matches in the dictionary.
+    */
+    enum MatchFinderType {
+        BRUTE_FORCE,
+        HASH_CHAIN,
+        /* Suits dictionaries of megabytes, `searchDepth` should be much smaller than for `HASH_CHAIN`. */
+        BINARY_TREE
+    };
+
+    /**
+    * Formats of packed triples.
+    */
+    enum TokenFormat {
+        /* Offset, length and character of fixed width. */
+        FIXED_WIDTH,
+        /* A flag, which tells if a match (of at least `MIN_MATCH_LENGTH_FLAGGED_LZ77` characters) precedes
+           the character, so single characters do not take place for offsets and lengths. */
+        FLAGGED,
+        /* The same as `FLAGGED`, but offsets are written with Elias delta code and lengths with Elias gamma code,
+           so near and short matches take less place. */
+        VARIABLE_LENGTH,
+        /* Characters, lengths and offsets are written as separate streams, each with its own Shannon-Fano code,
+           lengths and offsets are coded by buckets of their binary logarithms as in DEFLATE.
+           It can not be written by the streaming `Packer::writeTriples`. */
+        ENTROPY_CODED
+    };
+
+    /**
+    * `Settings` struct contains parameters of the search and the format, which triples are chosen for.
+    * Only the format affects which triples can be made, other parameters do not change the format of the output.
+    */
+    struct Settings {
+        MatchFinderType matchFinder;
+        /* Max number of candidates which are tested for each position. */
+        int searchDepth;
+        /* Length of a match which is good enough to stop the search. */
+        int niceLength;
+        /* Max number of characters by which a match can be deferred, `0` means greedy parsing. */
+        int lazyDepth;
+        /* Chooses triples with dynamic programming over their prices, `lazyDepth` is ignored then. */
+        bool isOptimalParsing;
+        TokenFormat format;
+        /* Binary logarithm of the number of anchors of long-distance matching, which takes 8 bytes per anchor.
+           `0` turns it off. Long-distance matches are farther than the dictionary, so they can be written
+           only in `VARIABLE_LENGTH` and `ENTROPY_CODED` formats, it is turned off by the coder in other formats.
+           They are not made by streaming coding. */
+        int longDistanceBits;
+
+        Settings() {
+            this->matchFinder = HASH_CHAIN;
+            this->searchDepth = constants::SEARCH_DEPTH_LZ77;
+            this->niceLength = constants::NICE_LENGTH_LZ77;
+            this->lazyDepth = 0;
+            this->isOptimalParsing = false;
+            this->format = FIXED_WIDTH;
+            this->longDistanceBits = 0;
+        }
+
+        Settings(MatchFinderType matchFinder, int searchDepth, int niceLength, int lazyDepth = 0,
+                 bool isOptimalParsing = false, TokenFormat format = FIXED_WIDTH) {
+            this->matchFinder = matchFinder;
+            this->searchDepth = searchDepth;
+            this->niceLength = niceLength;
+            this->lazyDepth = lazyDepth;
+            this->isOptimalParsing = isOptimalParsing;
+            this->format = format;
+            this->longDistanceBits = 0;
+        }
+    };
+
+    /**
+    * `Level` struct contains sizes of the dictionary and the window and settings of a compression level.
+    * Levels choose `VARIABLE_LENGTH` format, because deferred and optimally parsed matches pay off only
+    * in formats, where triples have different sizes, and it packs smaller than `FLAGGED` at every level.
+    */
+    struct Level {
+        int dictSize;
+        int windowSize;
+        Settings settings;
+
+        Level(int dictSize, int windowSize, const Settings& settings) {
+            this->dictSize = dictSize;
+            this->windowSize = windowSize;
+            this->settings = settings;
+        }
+    };
+
+    /**
+    * `StreamHeader` struct describes packed triples, so they can be read and encoded
+    * without knowing the parameters of the coder, which made them.
+    */
+    struct StreamHeader {
+        int dictSize;
+        int windowSize;
+        TokenFormat format;
+        /* ID of the preset dictionary or `0`. */
+        uint32_t dictionaryId;
+        /* Number of characters of the coded data. */
+        uint64_t originalSize;
+
+        StreamHeader() {
+            this->dictSize = 0;
+            this->windowSize = 0;
+            this->format = FIXED_WIDTH;
+            this->dictionaryId = 0;
+            this->originalSize = 0;
+        }
+    };
+
     /**
     * Creates a new instance of LZ77 coder with given dictionary's and window's sizes.
     */
-    LZ77Coder(int dictSize, int windowSize) {
+    LZ77Coder(int dictSize, int windowSize, Settings settings = Settings()) {
         this->dictSize = dictSize;
         this->windowSize = windowSize;
+        this->settings = settings;
+        this->dictionaryId = 0;
+
+        /// Offsets of other formats have fixed width, which fits only the dictionary.
+        if (settings.format != VARIABLE_LENGTH && settings.format != ENTROPY_CODED)
+            this->settings.longDistanceBits = 0;
+    }
+
+    /**
+    * Creates a new instance of LZ77 coder with sizes and settings of given compression level.
+    */
+    explicit LZ77Coder(const Level& level): LZ77Coder(level.dictSize, level.windowSize, level.settings) {}
+
+    /**
+    * Creates a new instance of LZ77 coder, which encodes triples described by given header.
+    * @param dictionary The preset dictionary, which the triples were coded with, its ID must match the header.
+    * @throws std::invalid_argument If the ID of given dictionary differs from the one in the header.
+    */
+    explicit LZ77Coder(const StreamHeader& header, const CharSequence& dictionary = CharSequence()):
+            LZ77Coder(header.dictSize, header.windowSize) {
+        this->settings.format = header.format;
+        if (!dictionary.empty())
+            setPresetDictionary(dictionary);
+
+        if (dictionaryId != header.dictionaryId)
+            throw std::invalid_argument("The preset dictionary does not match the one of the triples");
+    }
+
+    /**
+    * Returns compression level with given number from `MIN_LEVEL_LZ77` to `MAX_LEVEL_LZ77`.
+    * Higher levels search larger dictionaries deeper and defer matches, so they code better and slower.
+    * Levels up to the third one have the same sizes as the experiments with 5, 10 and 20 KB windows.
+    */
+    static Level level(int number) {
+        assert(number >= constants::MIN_LEVEL_LZ77 && number <= constants::MAX_LEVEL_LZ77);
+
+        static const std::vector<Level> levels{
+                Level(4 * 1024, 5 * 1024, Settings(HASH_CHAIN, 4, 32, 0, false, VARIABLE_LENGTH)),
+                Level(8 * 1024, 10 * 1024, Settings(HASH_CHAIN, 8, 64, 0, false, VARIABLE_LENGTH)),
+                Level(16 * 1024, 20 * 1024, Settings(HASH_CHAIN, 16, 128, 0, false, VARIABLE_LENGTH)),
+                Level(32 * 1024, 36 * 1024, Settings(HASH_CHAIN, 32, 128, 1, false, VARIABLE_LENGTH)),
+                Level(64 * 1024, 68 * 1024, Settings(HASH_CHAIN, 64, 256, 1, false, VARIABLE_LENGTH)),
+                Level(128 * 1024, 136 * 1024, Settings(HASH_CHAIN, 256, 256, 2, false, VARIABLE_LENGTH)),
+                Level(256 * 1024, 264 * 1024, Settings(BINARY_TREE, 32, 256, 2, false, VARIABLE_LENGTH)),
+                Level(1024 * 1024, 1032 * 1024, Settings(BINARY_TREE, 64, 512, 0, true, VARIABLE_LENGTH)),
+                Level(4 * 1024 * 1024, 4 * 1024 * 1024 + 16 * 1024,
+                      Settings(BINARY_TREE, 128, 1024, 0, true, VARIABLE_LENGTH))
+        };
+
+        return levels[number - constants::MIN_LEVEL_LZ77];
+    }
+
+    /**
+    * Sets a preset dictionary: coding and encoding start with its last `dictSize` characters in the dictionary
+    * instead of an empty one, so even short data has matches. Data must be encoded with the same preset dictionary,
+    * which it was coded with. An empty dictionary removes the preset one.
+    */
+    void setPresetDictionary(const CharSequence& dictionary) {
+        int presetSize = std::min(dictSize, static_cast<int>(dictionary.size()));
+        presetDictionary.assign(dictionary.end() - presetSize, dictionary.end());
+
+        /// `0` is kept for the absence of a dictionary.
+        dictionaryId = dictionary.empty() ? 0 : std::max(1u, utils::fnvHash(dictionary));
+        primedFinder = presetDictionary.empty() ? nullptr : makePrimedFinder();
+    }
+
+    /**
+    * Returns an ID of the preset dictionary, which is a hash of its characters, or `0` if there is no one.
+    */
+    uint32_t getDictionaryId() const {
+        return dictionaryId;
+    }
+
+    /**
+    * Returns a header of triples, which were made by this coder from data of given size.
+    */
+    StreamHeader makeHeader(uint64_t originalSize) const {
+        StreamHeader header;
+        header.dictSize = dictSize;
+        header.windowSize = windowSize;
+        header.format = settings.format;
+        header.dictionaryId = dictionaryId;
+        header.originalSize = originalSize;
+        return header;
+    }
+
+    /**
+    * Returns min length of a match, which can be written in given format.
+    */
+    static int minMatchLength(TokenFormat format) {
+        return format == FIXED_WIDTH ? 1 : constants::MIN_MATCH_LENGTH_FLAGGED_LZ77;
     }
 
     /**
     * Encodes given code, which was generated with LZ77 algorithm.
     */
+    CharSequence encode(const TripleBuffer& input) {
+        size_t size = 0;
+        for (const Triple& triple: input)
+            size += triple.length + 1;
+
+        return encode(input, size);
+    }
+
     CharSequence encode(const std::vector<Triple>& input) {
-        CharSequence encoded;
-        int pointer = 0;
+        return encode(TripleBuffer(input));
+    }
 
-        for (Triple triple: input) {
-            for (size_t index = pointer -  triple.offset; index < pointer - triple.offset + triple.length; ++index)
-                encoded.push_back(encoded[index]);
+    /**
+    * Encodes given code, which was generated with LZ77 algorithm, when the size of the original data is known.
+    * @throws std::runtime_error If the triples do not cover exactly `size` characters or refer before the data.
+    */
+    CharSequence encode(const TripleBuffer& input, size_t size) {
+        CharSequence encoded(size + constants::WIDE_COPY_SLACK_LZ77);
+        size_t pointer = 0;
+        encodeInto(input, encoded, pointer);
 
-            pointer += triple.length + 1;
-            encoded.push_back(triple.character);
+        if (pointer != size)
+            throw std::runtime_error("LZ77 triples are shorter than the encoded data");
+        encoded.resize(size);
+        return encoded;
+    }
+
+    /**
+    * Code given char sequence with LZ77 algorithm.
+    */
+    TripleBuffer code(const CharSequence& data) {
+        TripleBuffer coded;
+        if (presetDictionary.empty()) {
+            codeRange(data, 0, static_cast<long long>(data.size()), coded);
+            return coded;
         }
 
+        /// Characters of the preset dictionary are only added to the dictionary of the match finder.
+        int presetSize = static_cast<int>(presetDictionary.size());
+        CharSequence primed = withPresetDictionary(data, -presetSize, static_cast<long long>(data.size()));
+        codeRange(primed, presetSize, static_cast<long long>(primed.size()), coded, true, true);
+
+        return coded;
+    }
+
+    /**
+    * Encodes blocks, which were generated with `codeBlocks`. Triples of consecutive blocks form a single code,
+    * so the blocks are encoded one after another.
+    */
+    CharSequence encode(const std::vector<Block>& blocks) {
+        size_t size = 0;
+        for (const Block& block: blocks)
+            size += block.size;
+
+        CharSequence encoded(size + constants::WIDE_COPY_SLACK_LZ77);
+        size_t pointer = 0;
+        for (const Block& block: blocks)
+            encodeInto(block.triples, encoded, pointer);
+
+        if (pointer != size)
+            throw std::runtime_error("LZ77 triples are shorter than the encoded data");
+        encoded.resize(size);
         return encoded;
     }
 
     /**
-    * Code given char sequence with LZ77 algorithm.
+    * Code given char sequence with LZ77 algorithm by blocks of `blockSize` characters, which are coded in parallel.
+    * The result does not depend on the number of threads.
+    * @param overlap Number of characters before each block, which are added to its dictionary,
+    * so triples of the block may refer to the previous one. It is not more than the size of the dictionary.
+    * The preset dictionary is treated as characters before the first block.
+    * @param threads Number of threads, `0` means the number of hardware threads.
     */
-    std::vector<Triple> code(const CharSequence& data) {
-        std::vector<Triple> coded;
-        int dataSize = static_cast<int>(data.size());
-        coded.reserve(dataSize);
+    std::vector<Block> codeBlocks(const CharSequence& data, int blockSize, int overlap = 0, int threads = 0) const {
+        assert(blockSize > 0);
 
-        int dictLeftBorder = -dictSize;
-        int dictRightBorder = -1;
-        int bufferLeftBorder = 0;
-        int bufferRightBorder = windowSize - dictSize - 1;
+        long long dataSize = static_cast<long long>(data.size());
+        std::vector<Block> blocks(static_cast<size_t>((dataSize + blockSize - 1) / blockSize));
+        overlap = std::max(0, std::min(overlap, dictSize));
 
-        while (bufferLeftBorder < dataSize) {
+        ThreadPool pool(std::min(threads, static_cast<int>(blocks.size())));
+        for (int index = 0; index < static_cast<int>(blocks.size()); ++index) {
+            pool.submit([this, &data, &blocks, index, blockSize, overlap, dataSize] {
+                long long start = static_cast<long long>(index) * blockSize;
+                int primed = static_cast<int>(std::min<long long>(overlap, start + presetDictionary.size()));
+                long long end = std::min(dataSize, start + blockSize);
 
-            int possibleStart = dictLeftBorder;
-            int bestStart = dictLeftBorder;
-            int bestLength = 0;
-            for (; possibleStart <= dictRightBorder; ++possibleStart) {
-                if (possibleStart < 0)
-                    continue;
+                CharSequence part = withPresetDictionary(data, start - primed, end);
+                blocks[index].size = static_cast<int>(end - start);
+                bool isPrimed = start == 0 && primedFinder && primed == static_cast<int>(presetDictionary.size());
+                codeRange(part, primed, static_cast<long long>(part.size()), blocks[index].triples, true, isPrimed);
+            });
+        }
 
-                int firstIndex = possibleStart, secondIndex = bufferLeftBorder;
+        pool.wait();
+        return blocks;
+    }
 
-                while (firstIndex >= 0 && secondIndex >= 0 && firstIndex <= bufferRightBorder &&
-                       secondIndex <= bufferRightBorder && data[firstIndex] == data[secondIndex]) {
-                    firstIndex++;
-                    secondIndex++;
-                }
+    /**
+    * Code data from given stream with LZ77 algorithm. Only the dictionary, the look-ahead buffer and
+    * a chunk of new characters are kept in memory, and triples are passed to `consume` as soon as they are made.
+    */
+    void code(std::istream& input, const std::function<void(const Triple&)>& consume) const {
+        int lookAhead = windowSize - dictSize;
+        int chunkSize = std::max(constants::STREAM_CHUNK_LZ77, dictSize);
 
-                if (secondIndex >= bufferRightBorder) {
-                    secondIndex--;
-                    firstIndex--;
-                }
+        CharSequence buffer(presetDictionary);
+        buffer.reserve(dictSize + chunkSize + lookAhead);
+        TripleBuffer coded;
+        int bufferLeftBorder = static_cast<int>(presetDictionary.size());
+        bool isPrimed = primedFinder != nullptr;
 
-                int newLength = firstIndex - possibleStart;
-                if (newLength > bestLength) {
-                    bestLength = newLength;
-                    bestStart = possibleStart;
-                }
-            }
+        bool isEnd = false;
+        while (!isEnd) {
+            int size = static_cast<int>(buffer.size());
+            buffer.resize(dictSize + chunkSize + lookAhead);
+            input.read(buffer.data() + size, buffer.size() - size);
+            buffer.resize(size + static_cast<int>(input.gcount()));
 
-            int bestOffset = bestLength == 0 ? 0 : bufferLeftBorder - bestStart;
-            int nextCharacter = data[bufferLeftBorder + bestLength];
-            coded.push_back(Triple(bestOffset, bestLength, nextCharacter));
+            isEnd = !input;
+            int end = isEnd ? static_cast<int>(buffer.size()) : static_cast<int>(buffer.size()) - lookAhead;
+            if (bufferLeftBorder < end)
+                bufferLeftBorder = static_cast<int>(codeRange(buffer, bufferLeftBorder, end, coded, false, isPrimed));
 
-            dictLeftBorder += bestLength + 1;
-            dictRightBorder += bestLength + 1;
-            bufferLeftBorder += bestLength + 1;
-            bufferRightBorder += bestLength + 1;
+            for (const Triple& triple: coded)
+                consume(triple);
+            coded.clear();
 
-            dictRightBorder = std::min(dictRightBorder, dataSize - 1);
-            bufferRightBorder = std::min(bufferRightBorder, dataSize - 1);
+            /// Only the dictionary of the next triple is kept.
+            int removed = std::max(0, bufferLeftBorder - dictSize);
+            buffer.erase(buffer.begin(), buffer.begin() + removed);
+            bufferLeftBorder -= removed;
+            isPrimed = isPrimed && removed == 0;
         }
+    }
 
-        return coded;
+    /**
+    * Encodes triples, which are returned by `next` until it returns `false`, and writes the result to given stream.
+    * Only the dictionary and a chunk of new characters are kept in memory, so matches must not be farther
+    * than the dictionary, as the ones of streaming `code` are, and long-distance ones are not accepted.
+    * @throws std::runtime_error If a match is longer than the look-ahead buffer or is not in the dictionary.
+    */
+    void encode(const std::function<bool(Triple&)>& next, std::ostream& output) const {
+        int chunkSize = std::max(constants::STREAM_CHUNK_LZ77, dictSize);
+
+        CharSequence buffer(dictSize + chunkSize + windowSize - dictSize + constants::WIDE_COPY_SLACK_LZ77);
+        char* encoded = buffer.data();
+        std::copy(presetDictionary.begin(), presetDictionary.end(), encoded);
+        int pointer = static_cast<int>(presetDictionary.size());
+        int written = pointer;
+
+        Triple triple;
+        while (next(triple)) {
+            /// Triples may come from a corrupted stream, so they are checked before they are copied.
+            if (triple.length < 0 || triple.length >= windowSize - dictSize)
+                throw std::runtime_error("LZ77 match is longer than the look-ahead buffer");
+            if (triple.length > 0 && (triple.offset <= 0 || triple.offset > std::min(pointer, dictSize)))
+                throw std::runtime_error("LZ77 match is not in the dictionary");
+
+            WideCopy::copyMatch(encoded + pointer, triple.offset, triple.length);
+            pointer += triple.length;
+            encoded[pointer++] = triple.character;
+
+            if (pointer >= dictSize + chunkSize) {
+                output.write(encoded + written, pointer - written);
+                std::memmove(encoded, encoded + pointer - dictSize, dictSize);
+                pointer = written = dictSize;
+            }
+        }
+
+        output.write(encoded + written, pointer - written);
     }
 
 private:
@@ -127,4 +598,384 @@ private:
 
     /* Size of a window in number of characters. */
     int windowSize;
+
+    Settings settings;
+
+    /* The last `dictSize` characters of the preset dictionary. */
+    CharSequence presetDictionary;
+
+    uint32_t dictionaryId;
+
+    /**
+    * `PrimedFinder` struct contains match finders, which the characters of the preset dictionary were passed to,
+    * so they are not passed again for each coded data.
+    */
+    struct PrimedFinder {
+        CharSequence dictionary;
+        std::unique_ptr<MatchFinder> finder;
+        /* The finder with long-distance matching, if it is turned on. */
+        std::unique_ptr<MatchFinder> longDistanceFinder;
+        /* The first position of the dictionary, which was not passed to the finders. */
+        int end;
+    };
+
+    /* Match finder of the preset dictionary, it is shared by copies of the coder. */
+    std::shared_ptr<const PrimedFinder> primedFinder;
+
+
+    /**
+    * Returns characters of given data from position `from` to `to`. Positions are counted from the start of the data,
+    * so negative ones belong to the preset dictionary.
+    */
+    CharSequence withPresetDictionary(const CharSequence& data, long long from, long long to) const {
+        assert(-from <= static_cast<long long>(presetDictionary.size()));
+
+        CharSequence part(presetDictionary.end() + std::min(0LL, from), presetDictionary.end());
+        part.insert(part.end(), data.begin() + std::max(0LL, from), data.begin() + to);
+        return part;
+    }
+
+
+    /**
+    * Passes the characters of the preset dictionary to new match finders. The last characters are not passed,
+    * because their matches would be limited by the end of the dictionary and hashes would read the following data.
+    */
+    std::shared_ptr<const PrimedFinder> makePrimedFinder() const {
+        std::shared_ptr<PrimedFinder> primed(new PrimedFinder());
+        primed->dictionary = presetDictionary;
+        primed->finder = makeMatchFinder(primed->dictionary, false);
+        if (settings.longDistanceBits > 0)
+            primed->longDistanceFinder = makeMatchFinder(primed->dictionary, true);
+
+        int presetSize = static_cast<int>(presetDictionary.size());
+        int tail = std::max(std::max(windowSize - dictSize, constants::LONG_DISTANCE_WINDOW_LZ77),
+                            std::max(constants::HASH_BYTES_LZ77, constants::BINARY_TREE_HASH_BYTES_LZ77));
+        primed->end = std::max(0, presetSize - tail);
+        for (int position = 0; position < primed->end; ++position) {
+            primed->finder->skip(position, maxMatchLength(position, presetSize));
+            if (primed->longDistanceFinder)
+                primed->longDistanceFinder->skip(position, maxMatchLength(position, presetSize));
+        }
+
+        return primed;
+    }
+
+
+    /**
+    * Writes characters of given triples to `encoded` starting from `pointer`, and moves `pointer` after them.
+    * `encoded` must have `WIDE_COPY_SLACK_LZ77` spare characters after the last one of the triples.
+    * Matches, which start before the first character of `encoded`, are read from the preset dictionary.
+    */
+    void encodeInto(const TripleBuffer& input, CharSequence& encoded, size_t& pointer) const {
+        char* output = encoded.data();
+        for (const Triple& triple: input) {
+            /// Triples may be read from a corrupted file, so they are checked before they are copied.
+            if (triple.length < 0 || pointer + triple.length + 1 + constants::WIDE_COPY_SLACK_LZ77 > encoded.size())
+                throw std::runtime_error("LZ77 triples are longer than the encoded data");
+            if (triple.length > 0 &&
+                (triple.offset <= 0 || static_cast<size_t>(triple.offset) > pointer + presetDictionary.size()))
+                throw std::runtime_error("LZ77 match starts before the encoded data");
+
+            size_t length = triple.length;
+            if (length > 0 && static_cast<size_t>(triple.offset) > pointer) {
+                size_t beforeData = static_cast<size_t>(triple.offset) - pointer;
+                size_t fromPreset = std::min(length, beforeData);
+                CharSequence::const_iterator source = presetDictionary.end() - beforeData;
+                std::copy(source, source + fromPreset, output + pointer);
+                pointer += fromPreset;
+                length -= fromPreset;
+            }
+
+            WideCopy::copyMatch(output + pointer, triple.offset, static_cast<int>(length));
+            pointer += length;
+            output[pointer++] = triple.character;
+        }
+    }
+
+
+    /**
+    * Codes the characters of given data starting from position `start`, the characters before it
+    * are only added to the dictionary. Coding stops at the first triple, which ends not before `end`,
+    * but triples may use the characters after `end` as their look-ahead buffer.
+    * @param isLongDistance Allows matches, which are farther than the dictionary, if they are turned on.
+    * @param isPrimed Data starts with the preset dictionary, so the match finder is copied from the primed one.
+    * @return Position after the last triple.
+    */
+    long long codeRange(const CharSequence& data, long long start, long long end, TripleBuffer& coded,
+                        bool isLongDistance = true, bool isPrimed = false) const {
+        long long dataSize = static_cast<long long>(data.size());
+
+        isLongDistance = isLongDistance && settings.longDistanceBits > 0;
+        std::unique_ptr<MatchFinder> finder;
+        if (isPrimed) {
+            const MatchFinder& primed = isLongDistance ? *primedFinder->longDistanceFinder : *primedFinder->finder;
+            finder = primed.copyFor(data);
+        } else {
+            finder = makeMatchFinder(data, isLongDistance);
+        }
+        std::unique_ptr<PriceModel> prices = makePriceModel();
+        MatchCursor cursor(*finder, *this, dataSize, isPrimed ? primedFinder->end : 0);
+
+        if (settings.isOptimalParsing) {
+            return codeOptimally(data, start, end, cursor, *prices, coded);
+        }
+
+        long long bufferLeftBorder = start;
+        while (bufferLeftBorder < end) {
+            MatchFinder::Match best = cursor.longestMatch(bufferLeftBorder);
+
+            for (int deferral = 1; deferral <= settings.lazyDepth; ++deferral) {
+                if (deferral - 1 > best.length || bufferLeftBorder + deferral >= dataSize)
+                    break;
+                if (deferral > 1 && deferral - 1 < minMatchLength(settings.format))
+                    continue;
+
+                MatchFinder::Match deferred = cursor.longestMatch(bufferLeftBorder + deferral);
+                if (isDeferralCheaper(*prices, best, deferral, deferred)) {
+                    best = MatchFinder::Match(deferral == 1 ? 0 : best.offset, deferral - 1);
+                    break;
+                }
+            }
+
+            coded.push_back(Triple(best.offset, best.length, data[bufferLeftBorder + best.length]));
+            bufferLeftBorder += best.length + 1;
+        }
+
+        return bufferLeftBorder;
+    }
+
+    /**
+    * Passes positions to the match finder in ascending order. Positions, which were searched in advance
+    * (for example, by lazy evaluation), are remembered together with their longest matches.
+    */
+    class MatchCursor {
+    public:
+        /**
+        * @param firstPosition The first position, which was not passed to the finder yet.
+        */
+        MatchCursor(MatchFinder& finder, const LZ77Coder& coder, long long dataSize, long long firstPosition = 0):
+                finder(finder), coder(coder), dataSize(dataSize), firstSearched(0), nextPosition(firstPosition) {}
+
+        /**
+        * Returns the longest match, which starts at given position, or an empty match, if there is no one.
+        * Positions must not decrease from call to call.
+        */
+        MatchFinder::Match longestMatch(long long position) {
+            for (; !searched.empty() && firstSearched < position; ++firstSearched)
+                searched.pop_front();
+
+            if (position < nextPosition)
+                return searched.front();
+
+            /// Positions which were covered by the previous matches are still added to the dictionary.
+            for (; nextPosition < position; ++nextPosition)
+                finder.skip(nextPosition, coder.maxMatchLength(nextPosition, dataSize));
+
+            matches.clear();
+            finder.findMatches(position, coder.maxMatchLength(position, dataSize), matches);
+
+            /// Matches, which are too short for the format, are not used.
+            int minLength = minMatchLength(coder.settings.format);
+            while (!matches.empty() && matches.front().length < minLength)
+                matches.erase(matches.begin());
+            searched.push_back(matches.empty() ? MatchFinder::Match(0, 0) : matches.back());
+            firstSearched = position - static_cast<long long>(searched.size()) + 1;
+            nextPosition++;
+
+            return searched.back();
+        }
+
+        /**
+        * Returns all matches, which start at given position, ordered by length.
+        * Given position must not be searched before.
+        */
+        const std::vector<MatchFinder::Match>& allMatches(long long position) {
+            longestMatch(position);
+            return matches;
+        }
+
+    private:
+        MatchFinder& finder;
+        const LZ77Coder& coder;
+        long long dataSize;
+
+        /* Position of the first item of `searched`. */
+        long long firstSearched;
+
+        /* The first position which has not been passed to the finder yet. */
+        long long nextPosition;
+
+        std::deque<MatchFinder::Match> searched;
+        std::vector<MatchFinder::Match> matches;
+    };
+
+
+    /**
+    * Returns max length of a match starting at given position. The match must fit the look-ahead buffer
+    * and leave at least one character, which will be written after it.
+    */
+    int maxMatchLength(long long position, long long dataSize) const {
+        long long length = std::min<long long>(windowSize - dictSize - 1, dataSize - 1 - position);
+        return static_cast<int>(std::max(0LL, length));
+    }
+
+
+    /**
+    * Optimal parsing: chooses triples for the part of data, which starts at `bufferLeftBorder`, so that
+    * their total price is minimal. The part is finished when no triple can reach farther than the current position,
+    * or when it takes `OPTIMUM_WINDOW_LZ77` characters, or when a match longer than `OPTIMUM_NICE_LENGTH_LZ77`
+    * is found: such a match is taken without searching the positions which it covers.
+    */
+    long long codeOptimally(const CharSequence& data, long long start, long long end, MatchCursor& cursor,
+                            const PriceModel& prices, TripleBuffer& coded) const {
+        int niceLength = std::min(settings.niceLength, constants::OPTIMUM_NICE_LENGTH_LZ77);
+        int minLength = minMatchLength(settings.format);
+
+        /// For each position of the part: the least price of coding characters before it and the last triple.
+        std::vector<long long> cost(constants::OPTIMUM_WINDOW_LZ77 + 1);
+        std::vector<MatchFinder::Match> lastTriple(constants::OPTIMUM_WINDOW_LZ77 + 1, MatchFinder::Match(0, 0));
+        std::vector<MatchFinder::Match> path;
+
+        long long bufferLeftBorder = start;
+        while (bufferLeftBorder < end) {
+            int partSize = static_cast<int>(std::min<long long>(constants::OPTIMUM_WINDOW_LZ77,
+                                                                end - bufferLeftBorder));
+            std::fill(cost.begin(), cost.begin() + partSize + 1, LLONG_MAX);
+            cost[0] = 0;
+
+            int farthest = 0;
+            int current = 0;
+            MatchFinder::Match longMatch(0, 0);
+            for (; current < partSize && (current == 0 || current < farthest); ++current) {
+                const std::vector<MatchFinder::Match>& matches = cursor.allMatches(bufferLeftBorder + current);
+                if (!matches.empty() && matches.back().length >= niceLength) {
+                    longMatch = matches.back();
+                    break;
+                }
+
+                relax(cost, lastTriple, farthest, current, MatchFinder::Match(0, 0), prices.price(0, 0));
+
+                int previousLength = 0;
+                for (const MatchFinder::Match& match: matches) {
+                    int lastLength = std::min(match.length, partSize - current - 1);
+                    for (int length = std::max(previousLength + 1, minLength); length <= lastLength; ++length)
+                        relax(cost, lastTriple, farthest, current, MatchFinder::Match(match.offset, length),
+                              prices.price(match.offset, length));
+
+                    previousLength = match.length;
+                }
+            }
+
+            /// The long match may be taken from a position after the current one, if a triple reaches it cheaper,
+            /// or it may be not taken at all, if a triple reaches farther than its end.
+            int partEnd = current;
+            if (longMatch.length > 0) {
+                long long bestPrice = cost[current] + prices.price(longMatch.offset, longMatch.length);
+                for (int shift = 1; shift <= longMatch.length && current + shift <= farthest; ++shift) {
+                    int length = longMatch.length - shift;
+                    if (length > 0 && length < minLength)
+                        continue;
+
+                    if (cost[current + shift] == LLONG_MAX)
+                        continue;
+
+                    long long price = cost[current + shift] + prices.price(length == 0 ? 0 : longMatch.offset, length);
+                    if (price < bestPrice) {
+                        bestPrice = price;
+                        partEnd = current + shift;
+                    }
+                }
+
+                int longMatchEnd = current + longMatch.length + 1;
+                for (int position = longMatchEnd; position <= farthest; ++position) {
+                    if (cost[position] <= bestPrice)
+                        partEnd = position;
+                }
+
+                if (partEnd >= longMatchEnd)
+                    longMatch = MatchFinder::Match(0, 0);
+            }
+
+            path.clear();
+            for (int position = partEnd; position > 0; position -= lastTriple[position].length + 1)
+                path.push_back(lastTriple[position]);
+
+            for (int index = static_cast<int>(path.size()) - 1; index >= 0; --index) {
+                coded.push_back(Triple(path[index].offset, path[index].length,
+                                       data[bufferLeftBorder + path[index].length]));
+                bufferLeftBorder += path[index].length + 1;
+            }
+
+            if (longMatch.length > 0) {
+                int length = longMatch.length - (partEnd - current);
+                coded.push_back(Triple(length == 0 ? 0 : longMatch.offset, length, data[bufferLeftBorder + length]));
+                bufferLeftBorder += length + 1;
+            }
+        }
+
+        return bufferLeftBorder;
+    }
+
+
+    /**
+    * Updates the least price of the position after given triple, which starts at position `start`.
+    */
+    static void relax(std::vector<long long>& cost, std::vector<MatchFinder::Match>& lastTriple, int& farthest,
+                      int start, const MatchFinder::Match& triple, int price) {
+        int end = start + triple.length + 1;
+        if (cost[start] + price < cost[end]) {
+            cost[end] = cost[start] + price;
+            lastTriple[end] = triple;
+            farthest = std::max(farthest, end);
+        }
+    }
+
+
+    /**
+    * Lazy evaluation: checks if it is cheaper to write `deferral` characters with a prefix of the current match
+    * and a character after it, and then the match, which starts after them.
+    * The greedy way is estimated as the current match and the rest of the deferred match after it.
+    */
+    static bool isDeferralCheaper(const PriceModel& prices, const MatchFinder::Match& current, int deferral,
+                                  const MatchFinder::Match& deferred) {
+        int rest = deferral + deferred.length - current.length;
+        if (rest <= 0)
+            return false;
+
+        int lazyPrice = prices.price(deferral == 1 ? 0 : current.offset, deferral - 1) +
+                        prices.price(deferred.offset, deferred.length);
+        int greedyPrice = prices.price(current.offset, current.length) + prices.price(deferred.offset, rest - 1);
+
+        return lazyPrice < greedyPrice;
+    }
+
+
+    std::unique_ptr<PriceModel> makePriceModel() const {
+        if (settings.format == FLAGGED)
+            return std::unique_ptr<PriceModel>(new FlaggedPriceModel(dictSize, windowSize - dictSize));
+
+        /// Codes of `ENTROPY_CODED` format are known only after coding, so they are estimated with Elias codes.
+        if (settings.format == VARIABLE_LENGTH || settings.format == ENTROPY_CODED)
+            return std::unique_ptr<PriceModel>(new VariableLengthPriceModel());
+
+        return std::unique_ptr<PriceModel>(new FixedWidthPriceModel(dictSize, windowSize - dictSize));
+    }
+
+
+    std::unique_ptr<MatchFinder> makeMatchFinder(const CharSequence& data, bool isLongDistance) const {
+        std::unique_ptr<MatchFinder> finder;
+        if (settings.matchFinder == BRUTE_FORCE)
+            finder = std::unique_ptr<MatchFinder>(new BruteForceMatchFinder(data, dictSize));
+        else if (settings.matchFinder == BINARY_TREE)
+            finder = std::unique_ptr<MatchFinder>(new BinaryTreeMatchFinder(data, dictSize, settings.searchDepth,
+                                                                            settings.niceLength));
+        else
+            finder = std::unique_ptr<MatchFinder>(new HashChainMatchFinder(data, dictSize, settings.searchDepth,
+                                                                           settings.niceLength));
+
+        if (!isLongDistance)
+            return finder;
+        return std::unique_ptr<MatchFinder>(new LongDistanceMatchFinder(data, dictSize, std::move(finder),
+                                                                        settings.longDistanceBits));
+    }
 };
\ No newline at end of file
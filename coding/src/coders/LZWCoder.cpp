@@ -1,7 +1,12 @@
 #include <vector>
-#include <memory>
 #include <map>
-#include <set>
+#include <istream>
+#include <ostream>
+#include <functional>
+#include <algorithm>
+#include <climits>
+#include <cassert>
+#include <stdexcept>
 
 #ifndef COMMON_DECLARATIONS
 #define COMMON_DECLARATIONS
@@ -10,6 +15,27 @@
 
 #endif
 
+#ifndef LZW_HASH_DICTIONARY
+#define LZW_HASH_DICTIONARY
+
+#include "lzw/HashDictionary.cpp"
+
+#endif
+
+#ifndef LZW_WORD_TABLE
+#define LZW_WORD_TABLE
+
+#include "lzw/WordTable.cpp"
+
+#endif
+
+#ifndef THREAD_POOL
+#define THREAD_POOL
+
+#include "../common/ThreadPool.cpp"
+
+#endif
+
 /**
 Class which provides methods for coding/encoding data with LZW algorithm.
 */
@@ -17,29 +43,38 @@ class LZWCoder {
 
 public:
 
-
-    class Node {
-    public:
-        Node(int index, int character): index(index), character(character) {}
-
-        int index;
-        char character;
-
-        std::map<char, std::shared_ptr<Node>> next;
+    /**
+     * What happens, when the dictionary has `maxDictionarySize` words.
+     */
+    enum DictionaryPolicy {
+        /* New words are not added anymore. */
+        FREEZE,
+        /* `CLEAR_CODE_LZW` is written, and the dictionary starts again from single characters. */
+        CLEAR,
+        /* As `FREEZE`, but the ratio of characters to codes is checked every `MONITOR_GAP_LZW` characters
+           as in Unix `compress`, and the dictionary is cleared as in `CLEAR` when the ratio falls. */
+        MONITOR
     };
 
 
-    class Tree {
-    public:
-        Tree(): numberOfWords(0), root(new Node(-1, '\0')) {}
-
-        int numberOfWords;
-        std::shared_ptr<Node> root;
-    };
+    /**
+     * Creates a coder, which keeps not more than `maxDictionarySize` words (at least 256) in its dictionary.
+     * If the alphabet is implicit, the dictionary starts from all 256 characters as in coding of a stream,
+     * so the data is not scanned for its characters, and the result has no dictionary of characters.
+     * Data must be encoded by a coder with the same size, policy and alphabet.
+     */
+    explicit LZWCoder(int maxDictionarySize = INT_MAX, DictionaryPolicy policy = FREEZE,
+                      bool isAlphabetImplicit = false) {
+        assert(maxDictionarySize >= (1 << 8));
+        this->maxDictionarySize = maxDictionarySize;
+        this->policy = policy;
+        this->isAlphabetImplicit = isAlphabetImplicit;
+    }
 
 
     /** Represents the result of coding as vector with all codes and initial dictionary,
-     * which contains only one-length unique characters of source char sequence.
+     * which contains only one-length unique characters of source char sequence
+     * (it is empty, if the alphabet is implicit).
      */
     struct Result {
 
@@ -55,40 +90,64 @@ public:
     };
 
 
-    CharSequence encode(const Result& code) {
-        CharSequence encoded;
-        std::map<int, CharSequence > dictionary = code.dictionary;
+    /**
+     * `Block` struct contains number of characters of a part of data, which is coded separately, and its codes.
+     */
+    struct Block {
+        int size;
+        std::vector<int> codes;
 
-        /// Presents the word (without last character and with its index in dictionary),
-        /// which will be inserted on the next step, when it will be possible to determine the next character.
-        std::pair<CharSequence, int> notInitializedPair = std::make_pair(CharSequence{}, -1);
-        std::pair<CharSequence, int> futureObject = notInitializedPair;
+        Block() {
+            this->size = 0;
+        }
+    };
 
-        int lastIndex = static_cast<int>(dictionary.size()) + 1;
-        for (int index: code.codes) {
 
-            if (dictionary.find(index) != dictionary.end()) {
-                /// First case, when we have already found this word
-                if (futureObject != notInitializedPair) {
-                    CharSequence insertion(futureObject.first);
-                    insertion.push_back(dictionary[index][0]);
+    /**
+     * Sets a preset dictionary: its words are added to the dictionary before coding and encoding in the same way
+     * as words of the data, so even the first words of the data may be long. Data must be encoded
+     * with the same preset dictionary, which it was coded with.
+     */
+    void setPresetDictionary(const CharSequence& dictionary) {
+        presetDictionary = dictionary;
+    }
 
-                    dictionary[futureObject.second] = insertion;
-                }
 
-            } else {
-                /// Second case, when the word which we need to take is current `futureObject`
-                CharSequence insertion(futureObject.first);
-                insertion.push_back(futureObject.first[0]);
+    int getMaxDictionarySize() const {
+        return maxDictionarySize;
+    }
+
+    bool hasImplicitAlphabet() const {
+        return isAlphabetImplicit;
+    }
 
-                dictionary[futureObject.second] = insertion;
-            }
 
-            CharSequence prefix = dictionary[index];
-            encoded.insert(encoded.end(), prefix.begin(), prefix.end());
-            futureObject = std::make_pair(dictionary[index], lastIndex++);
+    CharSequence encode(const Result& code) {
+        assert(!isAlphabetImplicit || code.dictionary.empty());
+
+        HashDictionary initialDictionary;
+        if (isAlphabetImplicit) {
+            initialDictionary = implicitDictionary();
+        } else {
+            for (const std::pair<int, CharSequence>& item: code.dictionary)
+                initialDictionary.add(0, item.second[0]);
+            primeDictionary(initialDictionary);
         }
 
+        WordTable words(initialDictionary);
+        const int initialSize = words.size();
+        /// Each code adds not more than one word.
+        words.reserve(static_cast<int>(std::min<long long>(maxDictionarySize, initialSize + code.codes.size())) + 1);
+
+        /// The output is allocated once, and each word is written right to its place.
+        CharSequence encoded(encodedSize(code.codes, initialSize, words));
+        char* end = encoded.data();
+
+        int previous = -1;
+        for (int index: code.codes) {
+            end += addWord(index, initialSize, words, previous);
+            words.write(index, end);
+        }
 
         return encoded;
     }
@@ -96,46 +155,339 @@ public:
 
     Result code(const CharSequence& data) {
         /// Fills dictionary with init values (char sequences with size 1 which represents characters).
-        std::shared_ptr<Tree> dictionary = std::shared_ptr<Tree>(new Tree());
+        HashDictionary initialDictionary;
 
         /// Creates a default result, which will be filled with codes later.
         Result codedResult = Result();
-        fillDictionary(data, dictionary, codedResult.dictionary);
-
-        int position = 0;
-        int sourceSize = static_cast<int>(data.size());
-        while (position < sourceSize) {
-            std::pair<int, int> updateResult = searchAndInsertNextWord(data, position, dictionary);
-            position += updateResult.second - 1;
-            codedResult.codes.push_back(updateResult.first);
+        if (isAlphabetImplicit) {
+            initialDictionary = implicitDictionary();
+        } else {
+            fillDictionary(data, initialDictionary, codedResult.dictionary);
+            primeDictionary(initialDictionary);
         }
 
+        codeRange(data, 0, data.size(), initialDictionary, codedResult.codes);
         return codedResult;
     }
 
+    /**
+     * Code given char sequence with LZW algorithm by blocks of `blockSize` characters, which are coded in parallel.
+     * Each block has its own dictionary, which starts from all characters as with the implicit alphabet,
+     * so blocks may be encoded in parallel too. The result does not depend on the number of threads.
+     * @param threads Number of threads, `0` means the number of hardware threads.
+     */
+    std::vector<Block> codeBlocks(const CharSequence& data, int blockSize, int threads = 0) const {
+        assert(blockSize > 0);
+
+        /// Positions are `size_t`, so data may be longer than `INT_MAX` characters, only blocks may not.
+        std::vector<Block> blocks((data.size() + blockSize - 1) / blockSize);
+        const HashDictionary initialDictionary = implicitDictionary();
+
+        ThreadPool pool(static_cast<int>(std::min<size_t>(threads, blocks.size())));
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            pool.submit([this, &data, &blocks, &initialDictionary, index, blockSize] {
+                size_t start = index * blockSize;
+                size_t end = std::min(data.size(), start + blockSize);
+
+                blocks[index].size = static_cast<int>(end - start);
+                codeRange(data, start, end, initialDictionary, blocks[index].codes);
+            });
+        }
+
+        pool.wait();
+        return blocks;
+    }
+
+    /**
+     * Encodes blocks, which were generated with `codeBlocks`, in parallel. Each block is written straight
+     * to its place in the result.
+     * @param threads Number of threads, `0` means the number of hardware threads.
+     * @throws std::runtime_error If codes of a block make more or less characters than its size or are unknown.
+     */
+    CharSequence encode(const std::vector<Block>& blocks, int threads = 0) const {
+        std::vector<size_t> starts(blocks.size() + 1, 0);
+        for (size_t index = 0; index < blocks.size(); ++index)
+            starts[index + 1] = starts[index] + blocks[index].size;
+
+        CharSequence encoded(starts.back());
+        const WordTable initialWords(implicitDictionary());
+
+        ThreadPool pool(static_cast<int>(std::min<size_t>(threads, blocks.size())));
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            pool.submit([this, &blocks, &starts, &encoded, &initialWords, index] {
+                WordTable words = initialWords;
+                char* end = encoded.data() + starts[index];
+                char* blockEnd = encoded.data() + starts[index + 1];
+
+                int previous = -1;
+                for (int code: blocks[index].codes) {
+                    int length = addWord(code, initialWords.size(), words, previous);
+                    if (length > blockEnd - end)
+                        throw std::runtime_error("LZW codes do not match the size of their block");
+
+                    end += length;
+                    words.write(code, end);
+                }
+
+                if (end != blockEnd)
+                    throw std::runtime_error("LZW codes do not match the size of their block");
+            });
+        }
+
+        pool.wait();
+        return encoded;
+    }
+
+    /**
+     * Code data from given stream with LZW algorithm. The dictionary starts from all 256 characters, so the data
+     * is not read twice, and only the dictionary and a chunk of `STREAM_CHUNK_LZW` characters are kept in memory.
+     * Codes are passed to `consume` as soon as they are made.
+     */
+    void code(std::istream& input, const std::function<void(int)>& consume) {
+        const HashDictionary initialDictionary = implicitDictionary();
+        HashDictionary dictionary = initialDictionary;
+        Statistics statistics;
+
+        CharSequence chunk(constants::STREAM_CHUNK_LZW);
+        /// The longest word of the dictionary, which the last read characters make, and its length.
+        int code = 0;
+        int length = 0;
+        while (input) {
+            input.read(chunk.data(), chunk.size());
+            int size = static_cast<int>(input.gcount());
+
+            for (int position = 0; position < size; ++position) {
+                int next = dictionary.find(code, chunk[position]);
+                if (next >= 0) {
+                    code = next;
+                    length++;
+                    continue;
+                }
+
+                consume(code);
+                if (dictionary.size() <= maxDictionarySize)
+                    dictionary.add(code, chunk[position]);
+
+                /// The current character is not coded yet, so the data does not end here.
+                if (isClearing(length, dictionary, statistics)) {
+                    consume(constants::CLEAR_CODE_LZW);
+                    dictionary = initialDictionary;
+                    statistics = Statistics();
+                }
+
+                code = dictionary.find(0, chunk[position]);
+                length = 1;
+            }
+        }
+
+        if (length > 0)
+            consume(code);
+    }
+
+    /**
+     * Encodes codes, which are returned by `next` until it returns `false`, and writes the result to given stream.
+     * Codes must be made by coding of a stream. Only the dictionary and a chunk of characters are kept in memory.
+     */
+    void encode(const std::function<bool(int&)>& next, std::ostream& output) {
+        WordTable words(implicitDictionary());
+        const int initialSize = words.size();
+
+        CharSequence encoded(constants::STREAM_CHUNK_LZW);
+        size_t size = 0;
+
+        int previous = -1;
+        int index;
+        while (next(index)) {
+            size_t length = addWord(index, initialSize, words, previous);
+            if (size + length > encoded.size()) {
+                output.write(encoded.data(), size);
+                size = 0;
+                /// A word may be longer than a chunk only with a dictionary of very long words.
+                if (length > encoded.size())
+                    encoded.resize(length);
+            }
+
+            size += length;
+            words.write(index, encoded.data() + size);
+        }
+
+        output.write(encoded.data(), size);
+    }
+
+    /**
+     * Returns the greatest code, which can be made right after the start or a clearing, when the dictionary
+     * starts from all characters (coding of a stream or with the implicit alphabet).
+     * It is the number of characters and words of the preset dictionary.
+     */
+    int maxFirstImplicitCode() const {
+        return implicitDictionary().size() - 1;
+    }
+
 private:
 
+    /* Max number of words in the dictionary including single characters. */
+    int maxDictionarySize;
+
+    DictionaryPolicy policy;
+
+    bool isAlphabetImplicit;
+
+    CharSequence presetDictionary;
+
+
+    /**
+     * `Statistics` struct contains numbers of characters and codes since the last clearing of the dictionary
+     * and the ratio of them at the last check of `MONITOR` policy.
+     */
+    struct Statistics {
+        long long characters;
+        long long codes;
+        long long nextCheck;
+        double lastRatio;
+
+        Statistics(): characters(0), codes(0), nextCheck(0), lastRatio(0) {}
+    };
+
+
+    /**
+     * Counts the word of given length, which has just been coded, and checks if the dictionary must be cleared
+     * by the policy.
+     */
+    bool isClearing(int length, const HashDictionary& dictionary, Statistics& statistics) const {
+        bool isFull = dictionary.size() > maxDictionarySize;
+        statistics.characters += length;
+        statistics.codes++;
+
+        if (policy == MONITOR && isFull && statistics.characters >= statistics.nextCheck) {
+            double ratio = static_cast<double>(statistics.characters) / statistics.codes;
+            bool isFalling = ratio < statistics.lastRatio;
+            statistics.lastRatio = ratio;
+            statistics.nextCheck = statistics.characters + constants::MONITOR_GAP_LZW;
+            return isFalling;
+        }
+
+        return policy == CLEAR && isFull;
+    }
+
+
+    /**
+     * Adds the word, which is made by the previous code and given one, to given table and returns the length
+     * of the word with given code, so it can be written with `WordTable::write`. After a clearing the table
+     * is cut to `initialSize`, and `0` is returned: the clearing code is the code of the empty word.
+     * @param previous The previous code or `-1` after a clearing, it is replaced by given code.
+     * @throws std::runtime_error If given code is not in the table and is not the next code.
+     */
+    int addWord(int index, int initialSize, WordTable& words, int& previous) const {
+        if (index == constants::CLEAR_CODE_LZW) {
+            words.truncate(initialSize);
+            previous = -1;
+            return 0;
+        }
+
+        /// Codes may be read from a corrupted file, so a code must be known or be the next one.
+        if (index < 0 || index > words.size() || (index == words.size() && previous < 0))
+            throw std::runtime_error("Unknown LZW code");
+
+        if (previous >= 0 && words.size() <= maxDictionarySize) {
+            /// If the word is not known yet, it is the new word itself, so it starts as the previous one.
+            char character = words.firstCharacterOf(index < words.size() ? index : previous);
+            words.add(previous, character);
+        }
+
+        if (index >= words.size())
+            throw std::runtime_error("Unknown LZW code");
+        previous = index;
+        return words.lengthOf(index);
+    }
+
+
+    /**
+     * Returns number of characters, which given codes are encoded to. Words are added to given table
+     * as encoding adds them, and then the table is cut to `initialSize` again.
+     */
+    size_t encodedSize(const std::vector<int>& codes, int initialSize, WordTable& words) const {
+        size_t size = 0;
+        int previous = -1;
+        for (int index: codes)
+            size += addWord(index, initialSize, words, previous);
+
+        words.truncate(initialSize);
+        return size;
+    }
+
+
+    /**
+     * Returns the dictionary, which coding of a stream or with the implicit alphabet starts from:
+     * all characters in ascending order and words of the preset dictionary.
+     */
+    HashDictionary implicitDictionary() const {
+        HashDictionary dictionary;
+        for (int value = CHAR_MIN; value <= CHAR_MAX; ++value)
+            dictionary.add(0, static_cast<char>(value));
+
+        primeDictionary(dictionary);
+        return dictionary;
+    }
+
+
+    /**
+     * Codes characters of `data` from `from` to `to` starting from given dictionary and appends codes to `codes`.
+     */
+    void codeRange(const CharSequence& data, size_t from, size_t to, const HashDictionary& initialDictionary,
+                   std::vector<int>& codes) const {
+        HashDictionary dictionary = initialDictionary;
+        Statistics statistics;
+
+        size_t position = from;
+        while (position < to) {
+            std::pair<int, int> updateResult = searchAndInsertNextWord(data, position, to, dictionary);
+            position += updateResult.second - 1;
+            codes.push_back(updateResult.first);
+
+            if (isClearing(updateResult.second - 1, dictionary, statistics) && position < to) {
+                codes.push_back(constants::CLEAR_CODE_LZW);
+                dictionary = initialDictionary;
+                statistics = Statistics();
+            }
+        }
+    }
+
+
+    /**
+     * Inserts words of the preset dictionary into given dictionary, as if the preset dictionary was coded.
+     */
+    void primeDictionary(HashDictionary& dictionary) const {
+        size_t position = 0;
+        size_t presetSize = presetDictionary.size();
+        while (position < presetSize)
+            position += searchAndInsertNextWord(presetDictionary, position, presetSize, dictionary).second - 1;
+    }
+
+
     /**
      * Returns pair, where first number is the index of word which was found
-     * and the second number is the length of this word.
+     * and the second number is the length of this word. Characters from `end` are not read.
      */
-    std::pair<int, int> searchAndInsertNextWord(const CharSequence& source, int position, std::shared_ptr<Tree> dictionary) {
-        int sourceSize = static_cast<int>(source.size());
-        std::shared_ptr<Node> pointer = dictionary.get()->root;
+    std::pair<int, int> searchAndInsertNextWord(const CharSequence& source, size_t position, size_t end,
+                                                HashDictionary& dictionary) const {
+        int code = 0;
 
         int length = 1;
-        while (position < sourceSize) {
-            if (pointer.get()->next[source[position]] == nullptr) {
-                pointer.get()->next[source[position]] = std::shared_ptr<Node>(new Node(++(dictionary.get()->numberOfWords), source[position]));
+        while (position < end) {
+            int next = dictionary.find(code, source[position]);
+            if (next < 0) {
+                /// Codes of words start from 1, so a new word gets code `size()`.
+                if (dictionary.size() <= maxDictionarySize)
+                    dictionary.add(code, source[position]);
                 break;
             }
 
             length += 1;
-            pointer = pointer.get()->next[source[position]];
+            code = next;
             position++;
         }
 
-        return std::make_pair(pointer.get()->index, length);
+        return std::make_pair(code, length);
     }
 
 
@@ -143,19 +495,17 @@ private:
      * Fills a dictionary with unique characters of given char sequence.
      * Characters are sorted in ascending order.
      */
-    void fillDictionary(const CharSequence& data, std::shared_ptr<Tree> dictionary, std::map<int, CharSequence>& map) {
-        std::set<char> uniqueCharacters;
+    void fillDictionary(const CharSequence& data, HashDictionary& dictionary, std::map<int, CharSequence>& map) {
+        std::vector<bool> isPresent(1 << 8, false);
         for (char character: data)
-            uniqueCharacters.insert(character);
-
-        int sourceSize = static_cast<int>(data.size());
-        std::set<char>::iterator ptr = uniqueCharacters.begin();
-        for (int index = 1; ptr != uniqueCharacters.end(); ++index, ++ptr) {
-            if (dictionary.get()->root.get()->next[*ptr] == nullptr) {
-                map[index] = CharSequence{*ptr};
-                dictionary.get()->root.get()->next[*ptr] = std::shared_ptr<Node>(new Node(index, *ptr));
-                dictionary.get()->numberOfWords++;
-            }
+            isPresent[static_cast<unsigned char>(character)] = true;
+        for (char character: presetDictionary)
+            isPresent[static_cast<unsigned char>(character)] = true;
+
+        for (int value = CHAR_MIN; value <= CHAR_MAX; ++value) {
+            char character = static_cast<char>(value);
+            if (isPresent[static_cast<unsigned char>(character)])
+                map[dictionary.add(0, character)] = CharSequence{character};
         }
     }
 };
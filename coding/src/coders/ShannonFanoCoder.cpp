@@ -1,7 +1,7 @@
 #include <vector>
-#include <memory>
 #include <map>
 #include <algorithm>
+#include <cassert>
 
 #ifndef COMMON_DECLARATIONS
 #define COMMON_DECLARATIONS
@@ -46,20 +46,67 @@ public:
 
     class Node {
     public:
-        /* Only for creating the root of a total tree. */
-        Node(): left(nullptr), right(nullptr) {}
-        Node(char code): left(nullptr), right(nullptr) {}
+        Node(): value('\0'), left(-1), right(-1) {}
 
         /* Value which is associated with node only if this node is the end of some word. */
         char value;
 
-        bool isLeaf() {
-            return left == nullptr && right == nullptr;
+        bool isLeaf() const {
+            return left < 0 && right < 0;
         }
 
-        // `0` if left direction has been chosen, `1` otherwise
-        std::shared_ptr<Node> left;
-        std::shared_ptr<Node> right;
+        // `0` if left direction has been chosen, `1` otherwise, `-1` if there is no child
+        int left;
+        int right;
+    };
+
+    /**
+    * Binary tree with codes. Nodes are kept in one array and refer to their children by indices,
+    * so the tree is allocated and freed at once, and no reference counting is done while it is walked.
+    */
+    class Tree {
+    public:
+        /* Index of the root of a tree. */
+        static const int ROOT = 0;
+
+        Tree(): nodes(1) {}
+
+        /**
+        * Returns the index of the child of given node by given bit (`'0'` or `'1'`), `-1` if there is no child.
+        */
+        int next(int node, char bit) const {
+            return bit == '0' ? nodes[node].left : nodes[node].right;
+        }
+
+        const Node& operator[](int node) const {
+            return nodes[node];
+        }
+
+        /**
+        * Adds nodes on the path of given code, which are missing, and sets the value of its last node.
+        */
+        void add(char value, const CharSequence& code) {
+            int node = ROOT;
+            for (char bit: code) {
+                int child = next(node, bit);
+                if (child < 0) {
+                    child = static_cast<int>(nodes.size());
+                    /// Children are set after `push_back`, which may move the nodes.
+                    nodes.push_back(Node());
+                    (bit == '0' ? nodes[node].left : nodes[node].right) = child;
+                }
+                node = child;
+            }
+
+            nodes[node].value = value;
+        }
+
+        void reserve(int numberOfNodes) {
+            nodes.reserve(numberOfNodes);
+        }
+
+    private:
+        std::vector<Node> nodes;
     };
 
 
@@ -118,55 +165,40 @@ public:
     /**
      * Encodes a char sequence from given binary tree with codes.
      */
-    static CharSequence encodeSequence(const CharSequence& code, const std::shared_ptr<Node> tree) {
+    static CharSequence encodeSequence(const CharSequence& code, const Tree& tree) {
         CharSequence encodedData;
-        std::shared_ptr<Node> positionInTree = tree;
+        int positionInTree = Tree::ROOT;
 
         for (int indexOfPointer = 0; indexOfPointer <= static_cast<int>(code.size()); ++indexOfPointer) {
-            if (positionInTree.get()->isLeaf()) {
+            if (tree[positionInTree].isLeaf()) {
                 /// Updates encodedData variable which contains current result with new node's value.
-                encodedData.push_back(positionInTree.get()->value);
-                positionInTree = tree;
+                encodedData.push_back(tree[positionInTree].value);
+                positionInTree = Tree::ROOT;
 
                 indexOfPointer--;
                 continue;
             }
 
-            if (code[indexOfPointer] == '0')
-                positionInTree = positionInTree.get()->left;
-            else
-                positionInTree = positionInTree.get()->right;
+            positionInTree = tree.next(positionInTree, code[indexOfPointer]);
         }
 
         return encodedData;
     }
 
-    CharSequence encode(const CharSequence& code, const std::shared_ptr<Node> tree) {
+    CharSequence encode(const CharSequence& code, const Tree& tree) {
         return encodeSequence(code, tree);
     }
 
 
-    static std::shared_ptr<Node> makeTree(const std::map<char, CharSequence>& map) {
-        std::shared_ptr<Node> root = std::shared_ptr<Node>(new Node());
-
-        for (const std::pair<char, CharSequence>& item: map) {
-            std::shared_ptr<Node> pointer = root;
-            for (char bit: item.second) {
-                if (bit == '0') {
-                    if (pointer.get()->left == nullptr)
-                        pointer.get()->left = std::shared_ptr<Node>(new Node());
-                    pointer = pointer.get()->left;
-                } else {
-                    if (pointer.get()->right == nullptr)
-                        pointer.get()->right = std::shared_ptr<Node>(new Node());
-                    pointer = pointer.get()->right;
-                }
-            }
+    static Tree makeTree(const std::map<char, CharSequence>& map) {
+        Tree tree;
+        /// A full binary tree with `n` leaves has `2n - 1` nodes.
+        tree.reserve(2 * static_cast<int>(map.size()));
 
-            pointer.get()->value = item.first;
-        }
+        for (const std::pair<char, CharSequence>& item: map)
+            tree.add(item.first, item.second);
 
-        return root;
+        return tree;
     }
 
 private:
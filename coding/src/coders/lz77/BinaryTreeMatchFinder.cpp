@@ -0,0 +1,239 @@
+#include <cassert>
+
+#ifndef LZ77_MATCH_FINDER
+#define LZ77_MATCH_FINDER
+
+#include "MatchFinder.cpp"
+
+#endif
+
+/**
+Match finder which keeps positions with the same hash of the next `BINARY_TREE_HASH_BYTES_LZ77` characters
+in a binary search tree, ordered by the characters which follow each position. The newest position is always
+the root, so the search walks from the nearest positions to the farthest ones and passes only the positions
+which are lexicographically close to the look-ahead buffer. Every step of the walk is counted,
+so the cost of a search is bounded by `searchDepth` even for dictionaries of hundreds of megabytes.
+Matches shorter than the hashed prefix are found with the tables of the last positions of each character,
+each pair and each hash of three characters.
+*/
+class BinaryTreeMatchFinder : public MatchFinder {
+
+public:
+    BinaryTreeMatchFinder(const CharSequence& data, int dictSize, int searchDepth, int niceLength):
+            MatchFinder(data, dictSize), searchDepth(searchDepth), niceLength(std::max(niceLength, 1)),
+            lastCharacter(1 << 8, -1), lastPair(1 << 16, -1), lastTriple(1 << constants::HASH_BITS_LZ77, -1) {
+        /// The trees keep only the positions of the dictionary, so it is enough to store them cyclically.
+        cyclicSize = static_cast<int>(std::min(static_cast<size_t>(dictSize), data.size())) + 1;
+        tree = std::vector<long long>(2 * static_cast<size_t>(cyclicSize), -1);
+
+        headBits = 16;
+        while (headBits < constants::BINARY_TREE_HASH_BITS_LZ77 && (1 << (headBits + 1)) <= cyclicSize)
+            headBits++;
+        head = std::vector<long long>(static_cast<size_t>(1) << headBits, -1);
+    }
+
+    void findMatches(long long position, int maxLength, std::vector<Match>& matches) override {
+        int bestLength = 0;
+        long long lowestStart = position - dictSize;
+        long long dataSize = static_cast<long long>(data.size());
+
+        if (maxLength > 0)
+            updateBest(lastCharacter[character(position)], lowestStart, position, maxLength, bestLength, matches);
+
+        if (maxLength > 1 && position + 2 <= dataSize)
+            updateBest(lastPair[pairOf(position)], lowestStart, position, maxLength, bestLength, matches);
+
+        if (maxLength > 2 && position + 3 <= dataSize)
+            updateBest(lastTriple[tripleHashOf(position)], lowestStart, position, maxLength, bestLength, matches);
+
+        if (maxLength >= constants::BINARY_TREE_HASH_BYTES_LZ77) {
+            int lengthLimit = std::min(maxLength, niceLength);
+            bool isLimitReached = walkTree(position, lengthLimit, &matches, bestLength);
+            head[headHashOf(position)] = position;
+
+            /// The tree compares characters only up to the limit, so the longest match may continue after it.
+            if (isLimitReached && bestLength == lengthLimit && lengthLimit < maxLength) {
+                Match& longest = matches.back();
+                longest.length += matchLength(position - longest.offset + lengthLimit, position + lengthLimit,
+                                              maxLength - lengthLimit);
+            }
+        } else {
+            detach(position);
+        }
+
+        insert(position);
+    }
+
+    void skip(long long position, int maxLength) override {
+        if (maxLength >= constants::BINARY_TREE_HASH_BYTES_LZ77) {
+            int bestLength = 0;
+            walkTree(position, std::min(maxLength, niceLength), nullptr, bestLength);
+            head[headHashOf(position)] = position;
+        } else {
+            detach(position);
+        }
+
+        insert(position);
+    }
+
+    std::unique_ptr<MatchFinder> copyFor(const CharSequence& data) const override {
+        assert(this->data.size() <= data.size() && static_cast<int>(this->data.size()) <= dictSize);
+
+        BinaryTreeMatchFinder* copy = new BinaryTreeMatchFinder(data, dictSize, searchDepth, niceLength);
+        copy->lastCharacter = lastCharacter;
+        copy->lastPair = lastPair;
+        copy->lastTriple = lastTriple;
+
+        /// Roots are found by the hash of this finder, which may have less bits.
+        copy->headBits = headBits;
+        copy->head = head;
+
+        /// All positions are less than the cyclic size, so they keep their nodes in the longer tree.
+        std::copy(tree.begin(), tree.end(), copy->tree.begin());
+        return std::unique_ptr<MatchFinder>(copy);
+    }
+
+private:
+
+    /* Max number of nodes of the tree, which are visited for each search. */
+    int searchDepth;
+
+    /* Length of a match which is good enough to stop the search. */
+    int niceLength;
+
+    /* Number of positions stored in `tree`. */
+    int cyclicSize;
+
+    int headBits;
+
+    /* The root of the tree for each hash value. */
+    std::vector<long long> head;
+
+    /* Two children (lexicographically smaller and greater) for each position of the dictionary. */
+    std::vector<long long> tree;
+
+    std::vector<long long> lastCharacter;
+    std::vector<long long> lastPair;
+    std::vector<long long> lastTriple;
+
+
+    int character(long long position) const {
+        return static_cast<unsigned char>(data[position]);
+    }
+
+
+    int pairOf(long long position) const {
+        return (character(position) << 8) | character(position + 1);
+    }
+
+
+    int tripleHashOf(long long position) const {
+        unsigned int value = (character(position) << 16) | (character(position + 1) << 8) | character(position + 2);
+        return static_cast<int>((value * 2654435761u) >> (32 - constants::HASH_BITS_LZ77));
+    }
+
+
+    int headHashOf(long long position) const {
+        unsigned int value = 0;
+        for (int index = 0; index < constants::BINARY_TREE_HASH_BYTES_LZ77; ++index)
+            value = (value << 8) | character(position + index);
+
+        return static_cast<int>((value * 2654435761u) >> (32 - headBits));
+    }
+
+
+    size_t nodeOf(long long position) const {
+        return 2 * static_cast<size_t>(position % cyclicSize);
+    }
+
+
+    void updateBest(long long candidate, long long lowestStart, long long position, int maxLength,
+                    int& bestLength, std::vector<Match>& matches) const {
+        if (candidate < 0 || candidate < lowestStart)
+            return;
+
+        int length = matchLength(candidate, position, maxLength);
+        if (length > bestLength) {
+            bestLength = length;
+            matches.push_back(Match(position - candidate, length));
+        }
+    }
+
+
+    /**
+     * Searches the tree for given position and makes this position the new root of the tree.
+     * Nodes which are lexicographically smaller than the position form its left subtree,
+     * and nodes which are greater form its right subtree.
+     * @param matches Found matches are appended here, if it is not null.
+     * @return `true` if the walk has stopped, because a match with length `lengthLimit` has been found.
+     */
+    bool walkTree(long long position, int lengthLimit, std::vector<Match>* matches, int& bestLength) {
+        long long candidate = head[headHashOf(position)];
+
+        size_t node = nodeOf(position);
+        size_t smallerLink = node;
+        size_t greaterLink = node + 1;
+        int smallerLength = 0;
+        int greaterLength = 0;
+
+        for (int depth = 0; ; ++depth) {
+            long long delta = position - candidate;
+            if (candidate < 0 || delta >= cyclicSize || depth >= searchDepth) {
+                tree[smallerLink] = -1;
+                tree[greaterLink] = -1;
+                return false;
+            }
+
+            size_t candidateNode = nodeOf(candidate);
+            int length = std::min(smallerLength, greaterLength);
+            length += matchLength(candidate + length, position + length, lengthLimit - length);
+
+            if (length > bestLength) {
+                bestLength = length;
+                if (matches != nullptr)
+                    matches->push_back(Match(delta, length));
+            }
+
+            if (length == lengthLimit) {
+                /// The candidate is equal to the position as far as the tree can see, so it is replaced.
+                tree[smallerLink] = tree[candidateNode];
+                tree[greaterLink] = tree[candidateNode + 1];
+                return true;
+            }
+
+            if (character(candidate + length) < character(position + length)) {
+                tree[smallerLink] = candidate;
+                smallerLink = candidateNode + 1;
+                candidate = tree[smallerLink];
+                smallerLength = length;
+            } else {
+                tree[greaterLink] = candidate;
+                greaterLink = candidateNode;
+                candidate = tree[greaterLink];
+                greaterLength = length;
+            }
+        }
+    }
+
+
+    /**
+     * Marks given position as a position without subtrees, if it can not be inserted into a tree
+     * because of its short look-ahead buffer.
+     */
+    void detach(long long position) {
+        size_t node = nodeOf(position);
+        tree[node] = -1;
+        tree[node + 1] = -1;
+    }
+
+
+    void insert(long long position) {
+        long long dataSize = static_cast<long long>(data.size());
+
+        lastCharacter[character(position)] = position;
+        if (position + 2 <= dataSize)
+            lastPair[pairOf(position)] = position;
+        if (position + 3 <= dataSize)
+            lastTriple[tripleHashOf(position)] = position;
+    }
+};
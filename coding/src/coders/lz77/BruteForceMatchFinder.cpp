@@ -0,0 +1,35 @@
+#ifndef LZ77_MATCH_FINDER
+#define LZ77_MATCH_FINDER
+
+#include "MatchFinder.cpp"
+
+#endif
+
+/**
+Match finder which tests every position of the dictionary. It is slow, but always finds the longest match.
+*/
+class BruteForceMatchFinder : public MatchFinder {
+
+public:
+    BruteForceMatchFinder(const CharSequence& data, int dictSize): MatchFinder(data, dictSize) {}
+
+    void findMatches(long long position, int maxLength, std::vector<Match>& matches) override {
+        int bestLength = 0;
+        for (long long possibleStart = std::max(0LL, position - dictSize); possibleStart < position; ++possibleStart) {
+            int newLength = matchLength(possibleStart, position, maxLength);
+            if (newLength > bestLength) {
+                bestLength = newLength;
+                matches.push_back(Match(position - possibleStart, newLength));
+            }
+
+            if (bestLength == maxLength)
+                break;
+        }
+    }
+
+    void skip(long long position, int maxLength) override {}
+
+    std::unique_ptr<MatchFinder> copyFor(const CharSequence& data) const override {
+        return std::unique_ptr<MatchFinder>(new BruteForceMatchFinder(data, dictSize));
+    }
+};
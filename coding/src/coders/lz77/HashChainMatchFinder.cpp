@@ -0,0 +1,146 @@
+#include <cassert>
+
+#ifndef LZ77_MATCH_FINDER
+#define LZ77_MATCH_FINDER
+
+#include "MatchFinder.cpp"
+
+#endif
+
+/**
+Match finder which indexes the dictionary by a hash of the next `HASH_BYTES_LZ77` characters.
+Positions with the same hash are linked into a chain from the newest one to the oldest one,
+so only the positions from the chain are tested, and not more than `searchDepth` of them.
+Matches shorter than the hashed prefix are found with direct tables of the last positions of each character
+and each pair of characters.
+*/
+class HashChainMatchFinder : public MatchFinder {
+
+public:
+    HashChainMatchFinder(const CharSequence& data, int dictSize, int searchDepth, int niceLength):
+            MatchFinder(data, dictSize), searchDepth(searchDepth), niceLength(niceLength),
+            head(1 << constants::HASH_BITS_LZ77, -1), lastPair(1 << 16, -1), lastCharacter(1 << 8, -1) {
+        /// The chain keeps only the positions of the dictionary, so it is enough to store them cyclically.
+        size_t chainSize = 1;
+        while (chainSize <= std::min(static_cast<size_t>(dictSize), data.size()))
+            chainSize <<= 1;
+
+        chainMask = static_cast<long long>(chainSize) - 1;
+        chain = std::vector<long long>(chainSize, -1);
+    }
+
+    void findMatches(long long position, int maxLength, std::vector<Match>& matches) override {
+        int bestLength = 0;
+        long long lowestStart = position - dictSize;
+
+        if (maxLength > 0) {
+            long long candidate = lastCharacter[character(position)];
+            if (candidate >= 0 && candidate >= lowestStart)
+                updateBest(candidate, position, maxLength, bestLength, matches);
+        }
+
+        if (maxLength > 1 && bestLength < maxLength && position + 1 < static_cast<long long>(data.size())) {
+            long long candidate = lastPair[pairOf(position)];
+            if (candidate >= 0 && candidate >= lowestStart)
+                updateBest(candidate, position, maxLength, bestLength, matches);
+        }
+
+        if (maxLength >= constants::HASH_BYTES_LZ77 && bestLength < std::min(maxLength, niceLength)) {
+            long long candidate = head[hashOf(position)];
+            for (int depth = 0; depth < searchDepth && candidate >= 0 && candidate >= lowestStart; ++depth) {
+                if (data[candidate + bestLength] == data[position + bestLength]) {
+                    updateBest(candidate, position, maxLength, bestLength, matches);
+                    if (bestLength >= maxLength || bestLength >= niceLength)
+                        break;
+                }
+
+                long long next = chain[candidate & chainMask];
+                if (next >= candidate)
+                    break;
+                candidate = next;
+            }
+        }
+
+        insert(position);
+    }
+
+    void skip(long long position, int maxLength) override {
+        insert(position);
+    }
+
+    std::unique_ptr<MatchFinder> copyFor(const CharSequence& data) const override {
+        assert(this->data.size() <= data.size() && static_cast<int>(this->data.size()) <= dictSize);
+
+        HashChainMatchFinder* copy = new HashChainMatchFinder(data, dictSize, searchDepth, niceLength);
+        copy->head = head;
+        copy->lastPair = lastPair;
+        copy->lastCharacter = lastCharacter;
+
+        /// All positions are less than the size of the chain, so they keep their places in the longer chain.
+        std::copy(chain.begin(), chain.end(), copy->chain.begin());
+        return std::unique_ptr<MatchFinder>(copy);
+    }
+
+private:
+
+    /* Max number of positions from the chain, which are tested for each search. */
+    int searchDepth;
+
+    /* Length of a match which is good enough to stop the search. */
+    int niceLength;
+
+    long long chainMask;
+
+    /* The newest position for each hash value. */
+    std::vector<long long> head;
+
+    /* The previous position with the same hash for each position of the dictionary. */
+    std::vector<long long> chain;
+
+    std::vector<long long> lastPair;
+    std::vector<long long> lastCharacter;
+
+
+    int character(long long position) const {
+        return static_cast<unsigned char>(data[position]);
+    }
+
+
+    int pairOf(long long position) const {
+        return (character(position) << 8) | character(position + 1);
+    }
+
+
+    int hashOf(long long position) const {
+        unsigned int value = 0;
+        for (int index = 0; index < constants::HASH_BYTES_LZ77; ++index)
+            value = (value << 8) | character(position + index);
+
+        return static_cast<int>((value * 2654435761u) >> (32 - constants::HASH_BITS_LZ77));
+    }
+
+
+    void updateBest(long long candidate, long long position, int maxLength, int& bestLength,
+                    std::vector<Match>& matches) const {
+        int length = matchLength(candidate, position, maxLength);
+        if (length > bestLength) {
+            bestLength = length;
+            matches.push_back(Match(position - candidate, length));
+        }
+    }
+
+
+    void insert(long long position) {
+        long long dataSize = static_cast<long long>(data.size());
+
+        lastCharacter[character(position)] = position;
+        if (position + 1 < dataSize)
+            lastPair[pairOf(position)] = position;
+
+        if (position + constants::HASH_BYTES_LZ77 <= dataSize) {
+            int hash = hashOf(position);
+            chain[position & chainMask] = head[hash];
+            head[hash] = position;
+        }
+    }
+};
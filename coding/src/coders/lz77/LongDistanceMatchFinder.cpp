@@ -0,0 +1,132 @@
+#include <memory>
+#include <cassert>
+#include <cstdint>
+
+#ifndef LZ77_MATCH_FINDER
+#define LZ77_MATCH_FINDER
+
+#include "MatchFinder.cpp"
+
+#endif
+
+/**
+Match finder which adds long matches from the whole data to the matches of another finder, which searches
+only the dictionary. Windows of `LONG_DISTANCE_WINDOW_LZ77` characters are hashed with a rolling gear hash,
+and about one of `2^LONG_DISTANCE_ANCHOR_BITS_LZ77` positions, which is chosen by the hash, becomes an anchor.
+The newest anchor of each hash is kept in a table of `2^tableBits` positions, so memory does not depend
+on the size of the data. A match is searched only at anchors and at the offset of the previous long match,
+so the long match goes on after the look-ahead buffer ends.
+Offsets of the matches may be greater than the size of the dictionary.
+*/
+class LongDistanceMatchFinder : public MatchFinder {
+
+public:
+    LongDistanceMatchFinder(const CharSequence& data, int dictSize, std::unique_ptr<MatchFinder> finder,
+                            int tableBits):
+            MatchFinder(data, dictSize), finder(std::move(finder)), tableBits(tableBits),
+            anchors(static_cast<size_t>(1) << tableBits, -1), hash(0), hashedEnd(0), lastOffset(0) {
+        assert(tableBits > 0 && tableBits + constants::LONG_DISTANCE_ANCHOR_BITS_LZ77 <= 64);
+    }
+
+    void findMatches(long long position, int maxLength, std::vector<Match>& matches) override {
+        finder->findMatches(position, maxLength, matches);
+
+        int bestLength = matches.empty() ? 0 : matches.back().length;
+        if (lastOffset > 0 && lastOffset <= position)
+            updateBest(position - lastOffset, position, maxLength, bestLength, matches);
+
+        long long candidate = insert(position);
+        if (candidate >= 0)
+            updateBest(candidate, position, maxLength, bestLength, matches);
+    }
+
+    void skip(long long position, int maxLength) override {
+        finder->skip(position, maxLength);
+        insert(position);
+    }
+
+    std::unique_ptr<MatchFinder> copyFor(const CharSequence& data) const override {
+        LongDistanceMatchFinder* copy = new LongDistanceMatchFinder(data, dictSize, finder->copyFor(data), tableBits);
+        copy->anchors = anchors;
+        copy->hash = hash;
+        copy->hashedEnd = hashedEnd;
+        copy->lastOffset = lastOffset;
+        return std::unique_ptr<MatchFinder>(copy);
+    }
+
+private:
+
+    std::unique_ptr<MatchFinder> finder;
+
+    int tableBits;
+
+    /* The newest anchor for each bucket of the hash. */
+    std::vector<long long> anchors;
+
+    /* Gear hash of the window, which ends before `hashedEnd`. */
+    uint64_t hash;
+
+    long long hashedEnd;
+
+    /* Offset of the last found long match. */
+    long long lastOffset;
+
+
+    /**
+    * Returns a random number for each character, which is the same for every run.
+    */
+    static const std::vector<uint64_t>& gear() {
+        static const std::vector<uint64_t> table = [] {
+            std::vector<uint64_t> numbers(1 << 8);
+            uint64_t state = 0x9E3779B97F4A7C15ULL;
+            for (uint64_t& number: numbers) {
+                state += 0x9E3779B97F4A7C15ULL;
+                uint64_t value = state;
+                value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+                number = value ^ (value >> 31);
+            }
+            return numbers;
+        }();
+
+        return table;
+    }
+
+
+    /**
+    * Adds the window, which starts at given position, to the hash. If the position is an anchor,
+    * replaces the previous anchor with the same hash by it.
+    * @return The previous anchor with the same hash or `-1`.
+    */
+    long long insert(long long position) {
+        long long windowEnd = position + constants::LONG_DISTANCE_WINDOW_LZ77;
+        if (windowEnd > static_cast<long long>(data.size()))
+            return -1;
+
+        /// Each character is shifted by one bit further, so only the last 64 characters affect the hash.
+        const std::vector<uint64_t>& numbers = gear();
+        for (; hashedEnd < windowEnd; ++hashedEnd)
+            hash = (hash << 1) + numbers[static_cast<unsigned char>(data[hashedEnd])];
+
+        /// High bits depend on the whole window, so they are used both for choosing anchors and for the table.
+        uint64_t anchorMask = (static_cast<uint64_t>(1) << constants::LONG_DISTANCE_ANCHOR_BITS_LZ77) - 1;
+        if (((hash >> (64 - tableBits - constants::LONG_DISTANCE_ANCHOR_BITS_LZ77)) & anchorMask) != 0)
+            return -1;
+
+        long long& anchor = anchors[hash >> (64 - tableBits)];
+        long long candidate = anchor;
+        anchor = position;
+        return candidate;
+    }
+
+
+    void updateBest(long long candidate, long long position, int maxLength, int& bestLength,
+                    std::vector<Match>& matches) {
+        int length = matchLength(candidate, position, maxLength);
+        if (length >= constants::LONG_DISTANCE_MIN_LENGTH_LZ77 && length > bestLength) {
+            bestLength = length;
+            lastOffset = position - candidate;
+            matches.push_back(Match(position - candidate, length));
+        }
+    }
+};
@@ -0,0 +1,75 @@
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#ifndef COMMON_DECLARATIONS
+#define COMMON_DECLARATIONS
+
+#include "../../common/declarations.cpp"
+
+#endif
+
+#ifndef LZ77_MATCH_LENGTH
+#define LZ77_MATCH_LENGTH
+
+#include "MatchLength.cpp"
+
+#endif
+
+/**
+Base class for structures which search the dictionary of LZ77 for matches with the look-ahead buffer.
+*/
+class MatchFinder {
+
+public:
+    /**
+    * `Match` struct contains offset, which is calculated from the right to the left,
+    * and length of an equal part. Offsets and positions are 64-bit, so data may be larger than 2 GB.
+    */
+    struct Match {
+        long long offset;
+        int length;
+
+        Match(long long offset, int length): offset(offset), length(length) {}
+    };
+
+    MatchFinder(const CharSequence& data, int dictSize): data(data), dictSize(dictSize) {}
+
+    virtual ~MatchFinder() {}
+
+    /**
+     * Searches for matches which start at given position and inserts the position into the finder.
+     * Positions must be passed to `findMatches` or `skip` exactly once and in ascending order.
+     * @param position Index of the first character of the look-ahead buffer.
+     * @param maxLength Max possible length of a match.
+     * @param matches Found matches are appended here, their lengths are strictly increasing,
+     * so the last one is the longest.
+     */
+    virtual void findMatches(long long position, int maxLength, std::vector<Match>& matches) = 0;
+
+    /**
+     * Inserts given position into the finder without searching for matches.
+     */
+    virtual void skip(long long position, int maxLength) = 0;
+
+    /**
+     * Makes a finder for given data, which has the same positions as this finder, so the positions
+     * are not passed to the new finder again. The data must start with the data of this finder,
+     * which must not be longer than the dictionary.
+     */
+    virtual std::unique_ptr<MatchFinder> copyFor(const CharSequence& data) const = 0;
+
+protected:
+
+    const CharSequence& data;
+
+    /* Size of a dictionary in number of characters. */
+    int dictSize;
+
+    /**
+     * Counts how many characters are equal starting from given positions, but not more than `limit`.
+     */
+    int matchLength(long long first, long long second, int limit) const {
+        return MatchLength::compute(data.data() + first, data.data() + second, limit);
+    }
+};
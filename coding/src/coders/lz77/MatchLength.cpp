@@ -0,0 +1,104 @@
+#include <cstring>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MATCH_LENGTH_X86
+#endif
+
+/**
+Kernels, which count how many characters are equal starting from two given pointers.
+Characters are compared by 8, 16 or 32 at once, and the first mismatch is found by counting trailing zeros.
+The fastest kernel, which is supported by the processor, is chosen once at runtime.
+Kernels never read characters after `limit`.
+*/
+class MatchLength {
+
+public:
+    typedef int (*Kernel)(const char* first, const char* second, int limit);
+
+    static int compute(const char* first, const char* second, int limit) {
+        /// Most of candidates differ at once, so they are rejected without calling a kernel.
+        if (limit <= 0 || *first != *second)
+            return 0;
+
+        static const Kernel kernel = choose();
+        return kernel(first, second, limit);
+    }
+
+    static int scalar(const char* first, const char* second, int limit) {
+        int length = 0;
+        for (; length + 8 <= limit; length += 8) {
+            uint64_t firstWord, secondWord;
+            std::memcpy(&firstWord, first + length, 8);
+            std::memcpy(&secondWord, second + length, 8);
+
+            /// Words are loaded in little-endian order, so the first different character has the lowest set bit.
+            uint64_t difference = firstWord ^ secondWord;
+            if (difference != 0 && isLittleEndian())
+                return length + __builtin_ctzll(difference) / 8;
+            if (difference != 0)
+                break;
+        }
+
+        while (length < limit && first[length] == second[length])
+            length++;
+
+        return length;
+    }
+
+#if defined(MATCH_LENGTH_X86)
+    __attribute__((target("sse2")))
+    static int sse2(const char* first, const char* second, int limit) {
+        int length = 0;
+        for (; length + 16 <= limit; length += 16) {
+            __m128i firstVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + length));
+            __m128i secondVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + length));
+
+            unsigned int equal = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(firstVector, secondVector)));
+            if (equal != 0xFFFFu)
+                return length + __builtin_ctz(~equal);
+        }
+
+        return length + scalar(first + length, second + length, limit - length);
+    }
+
+
+    __attribute__((target("avx2")))
+    static int avx2(const char* first, const char* second, int limit) {
+        int length = 0;
+        for (; length + 32 <= limit; length += 32) {
+            __m256i firstVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + length));
+            __m256i secondVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + length));
+
+            unsigned int equal = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(firstVector,
+                                                                                                  secondVector)));
+            if (equal != 0xFFFFFFFFu)
+                return length + __builtin_ctz(~equal);
+        }
+
+        return length + sse2(first + length, second + length, limit - length);
+    }
+#endif
+
+private:
+
+    static bool isLittleEndian() {
+        const uint16_t value = 1;
+        unsigned char firstByte;
+        std::memcpy(&firstByte, &value, 1);
+        return firstByte == 1;
+    }
+
+
+    static Kernel choose() {
+#if defined(MATCH_LENGTH_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return &MatchLength::avx2;
+        if (__builtin_cpu_supports("sse2"))
+            return &MatchLength::sse2;
+#endif
+        return &MatchLength::scalar;
+    }
+};
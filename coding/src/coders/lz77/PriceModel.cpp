@@ -0,0 +1,96 @@
+#ifndef COMMON_DECLARATIONS
+#define COMMON_DECLARATIONS
+
+#include "../../common/declarations.cpp"
+
+#endif
+
+/**
+Base class for estimations of the size of LZ77 triples in the packed output.
+Parsers use it to choose between several ways to code the same characters.
+*/
+class PriceModel {
+
+public:
+    virtual ~PriceModel() {}
+
+    /**
+     * Returns number of bits which is taken by a triple with given offset and length,
+     * the character after the match included. Triples with zero length are single characters.
+     */
+    virtual int price(long long offset, int length) const = 0;
+};
+
+
+/**
+Prices of triples, which are written by `Packer::writeTriples`: all fields have fixed width,
+so every triple takes the same number of bits.
+*/
+class FixedWidthPriceModel : public PriceModel {
+
+public:
+    FixedWidthPriceModel(int charsInDictionary, int charsInBuffer) {
+        this->bitsPerTriple = utils::offsetBitsLZ77(charsInDictionary) + utils::lengthBitsLZ77(charsInBuffer) +
+                              constants::BITS_PER_CHARACTER_LZ77;
+    }
+
+    int price(long long offset, int length) const override {
+        return bitsPerTriple;
+    }
+
+private:
+
+    int bitsPerTriple;
+};
+
+
+/**
+Prices of triples in `FLAGGED` format: a flag tells if a match precedes the character,
+so a single character takes only one bit more than the character itself.
+*/
+class FlaggedPriceModel : public PriceModel {
+
+public:
+    FlaggedPriceModel(int charsInDictionary, int charsInBuffer) {
+        this->bitsPerCharacter = 1 + constants::BITS_PER_CHARACTER_LZ77;
+        this->bitsPerMatch = utils::offsetBitsLZ77(charsInDictionary) + utils::lengthBitsLZ77(charsInBuffer);
+    }
+
+    int price(long long offset, int length) const override {
+        if (length == 0)
+            return bitsPerCharacter;
+
+        /// Matches, which are shorter than the min length, can be written only as single characters.
+        if (length < constants::MIN_MATCH_LENGTH_FLAGGED_LZ77)
+            return (length + 1) * bitsPerCharacter;
+
+        return bitsPerMatch + bitsPerCharacter;
+    }
+
+private:
+
+    int bitsPerCharacter;
+
+    int bitsPerMatch;
+};
+
+
+/**
+Prices of triples in `VARIABLE_LENGTH` format: the same as in `FLAGGED` format, but offsets are written
+with Elias delta code and lengths with Elias gamma code, so the price grows with them.
+*/
+class VariableLengthPriceModel : public PriceModel {
+
+public:
+    int price(long long offset, int length) const override {
+        int bitsPerCharacter = 1 + constants::BITS_PER_CHARACTER_LZ77;
+        if (length == 0)
+            return bitsPerCharacter;
+
+        if (length < constants::MIN_MATCH_LENGTH_FLAGGED_LZ77)
+            return (length + 1) * bitsPerCharacter;
+
+        return utils::eliasDeltaBits(offset) +
+               utils::eliasGammaBits(length - constants::MIN_MATCH_LENGTH_FLAGGED_LZ77 + 1) + bitsPerCharacter;
+    }
+};
@@ -0,0 +1,64 @@
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#ifndef COMMON_DECLARATIONS
+#define COMMON_DECLARATIONS
+
+#include "../../common/declarations.cpp"
+
+#endif
+
+/**
+Copying of LZ77 matches by whole vector registers instead of single characters.
+A copy may write up to `WIDE_COPY_SLACK_LZ77` characters after the end of the match,
+so the output must have this number of spare characters after its end.
+*/
+class WideCopy {
+
+public:
+
+#if defined(__AVX2__)
+    static const int WIDTH = 32;
+#else
+    static const int WIDTH = 16;
+#endif
+
+    /**
+     * Copies `length` characters which start `offset` characters before `destination` to `destination`.
+     * The match may overlap itself (`offset` < `length`), then its first `offset` characters are repeated.
+     */
+    static void copyMatch(char* destination, long long offset, int length) {
+        const char* source = destination - offset;
+        char* end = destination + length;
+
+        /// Characters of an overlapping match are periodic, so the already copied part can be copied again
+        /// from the same source, and the distance between the source and the destination doubles each time.
+        while (destination - source < WIDTH && destination < end) {
+            std::memcpy(destination, source, destination - source);
+            destination += destination - source;
+        }
+
+        while (destination < end) {
+            copyVector(destination, source);
+            destination += WIDTH;
+            source += WIDTH;
+        }
+    }
+
+private:
+
+    static void copyVector(char* destination, const char* source) {
+#if defined(__AVX2__)
+        __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), vector);
+#elif defined(__SSE2__)
+        __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), vector);
+#else
+        std::memcpy(destination, source, WIDTH);
+#endif
+    }
+};
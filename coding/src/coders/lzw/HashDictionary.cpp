@@ -0,0 +1,114 @@
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef COMMON_DECLARATIONS
+#define COMMON_DECLARATIONS
+
+#include "../../common/declarations.cpp"
+
+#endif
+
+/**
+Dictionary of LZW, where each word is its prefix (a shorter word) and its last character.
+Words are stored in arrays by their codes, and the code of the word with given prefix and character is found
+with an open addressing hash table, which keeps only the codes. Words of one character are found
+in a direct table by their character. Code `0` is the empty word, so words of one character have it as their prefix.
+*/
+class HashDictionary {
+
+public:
+    HashDictionary(): mask(constants::INITIAL_TABLE_SIZE_LZW - 1), table(constants::INITIAL_TABLE_SIZE_LZW, -1),
+                      singles(1 << 8, -1), prefixes(1, -1), characters(1, '\0') {}
+
+    /**
+     * Returns the code of the word, which consists of the word with code `prefix` and given character,
+     * or `-1`, if there is no such word.
+     */
+    int find(int prefix, char character) const {
+        if (prefix == 0)
+            return singles[static_cast<unsigned char>(character)];
+
+        for (size_t slot = slotOf(prefix, character); ; slot = (slot + 1) & mask) {
+            int code = table[slot];
+            if (code < 0 || (prefixes[code] == prefix && characters[code] == character))
+                return code;
+        }
+    }
+
+    /**
+     * Adds the word, which consists of the word with code `prefix` and given character.
+     * The word must not be in the dictionary.
+     * @return Code of the new word, codes are given in ascending order.
+     */
+    int add(int prefix, char character) {
+        /// The table is kept at most half full, so probe sequences stay short.
+        if (prefix != 0 && 2 * (size() + 1) > static_cast<int>(table.size()))
+            grow();
+
+        int code = size();
+        prefixes.push_back(prefix);
+        characters.push_back(character);
+
+        if (prefix == 0)
+            singles[static_cast<unsigned char>(character)] = code;
+        else
+            insert(code);
+
+        return code;
+    }
+
+    /**
+     * Returns number of codes including the code of the empty word.
+     */
+    int size() const {
+        return static_cast<int>(prefixes.size());
+    }
+
+    int prefixOf(int code) const {
+        return prefixes[code];
+    }
+
+    char characterOf(int code) const {
+        return characters[code];
+    }
+
+private:
+
+    size_t mask;
+
+    /* Codes of words by the hash of their prefixes and last characters, `-1` means an empty slot. */
+    std::vector<int> table;
+
+    /* Codes of words of one character. */
+    std::vector<int> singles;
+
+    std::vector<int> prefixes;
+    std::vector<char> characters;
+
+
+    size_t slotOf(int prefix, char character) const {
+        uint64_t key = (static_cast<uint64_t>(prefix) << 8) | static_cast<unsigned char>(character);
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    }
+
+
+    void insert(int code) {
+        size_t slot = slotOf(prefixes[code], characters[code]);
+        while (table[slot] >= 0)
+            slot = (slot + 1) & mask;
+
+        table[slot] = code;
+    }
+
+
+    void grow() {
+        table.assign(2 * table.size(), -1);
+        mask = table.size() - 1;
+
+        for (int code = 1; code < size(); ++code) {
+            if (prefixes[code] != 0)
+                insert(code);
+        }
+    }
+};
@@ -0,0 +1,85 @@
+#include <vector>
+
+#ifndef LZW_HASH_DICTIONARY
+#define LZW_HASH_DICTIONARY
+
+#include "HashDictionary.cpp"
+
+#endif
+
+/**
+Dictionary of the LZW decoder. Each word is stored by its code as its prefix, its last character, its length
+and its first character, so a word is written backwards from its last character without copying other words.
+*/
+class WordTable {
+
+public:
+    /**
+     * Creates a table with the same words and codes as given dictionary.
+     */
+    explicit WordTable(const HashDictionary& dictionary): prefixes(1, -1), lastCharacters(1, '\0'),
+                                                          lengths(1, 0), firstCharacters(1, '\0') {
+        for (int code = 1; code < dictionary.size(); ++code)
+            add(dictionary.prefixOf(code), dictionary.characterOf(code));
+    }
+
+    /**
+     * Adds the word, which consists of the word with code `prefix` and given character.
+     */
+    void add(int prefix, char character) {
+        prefixes.push_back(prefix);
+        lastCharacters.push_back(character);
+        lengths.push_back(lengths[prefix] + 1);
+        firstCharacters.push_back(prefix == 0 ? character : firstCharacters[prefix]);
+    }
+
+    /**
+     * Reserves memory for given number of codes, so words are added without reallocations.
+     */
+    void reserve(int size) {
+        prefixes.reserve(size);
+        lastCharacters.reserve(size);
+        lengths.reserve(size);
+        firstCharacters.reserve(size);
+    }
+
+    /**
+     * Removes all words with codes not less than given size.
+     */
+    void truncate(int size) {
+        prefixes.resize(size);
+        lastCharacters.resize(size);
+        lengths.resize(size);
+        firstCharacters.resize(size);
+    }
+
+    /**
+     * Returns number of codes including the code of the empty word.
+     */
+    int size() const {
+        return static_cast<int>(prefixes.size());
+    }
+
+    int lengthOf(int code) const {
+        return lengths[code];
+    }
+
+    char firstCharacterOf(int code) const {
+        return firstCharacters[code];
+    }
+
+    /**
+     * Writes the word with given code, so that its last character is right before `end`.
+     */
+    void write(int code, char* end) const {
+        for (; code != 0; code = prefixes[code])
+            *--end = lastCharacters[code];
+    }
+
+private:
+
+    std::vector<int> prefixes;
+    std::vector<char> lastCharacters;
+    std::vector<int> lengths;
+    std::vector<char> firstCharacters;
+};
@@ -0,0 +1,51 @@
+#include <istream>
+#include <cassert>
+#include <stdexcept>
+
+/**
+Reads values with given number of bits from a binary stream, which was written by `BitWriter`.
+*/
+class BitReader {
+
+public:
+    explicit BitReader(std::istream& input): input(input), buffer(0), bitsInBuffer(0) {}
+
+    /**
+     * Checks if the stream has at least given number of bits (not more than 32), which are not read yet.
+     */
+    bool hasBits(int numberOfBits) {
+        assert(numberOfBits <= 32);
+
+        while (bitsInBuffer < numberOfBits) {
+            int next = input.get();
+            if (next == std::istream::traits_type::eof())
+                return false;
+
+            buffer = (buffer << 8) | static_cast<unsigned char>(next);
+            bitsInBuffer += 8;
+        }
+
+        return true;
+    }
+
+    /**
+     * Reads a value with given number of bits, `numberOfBits` must not be more than 32.
+     * @throws std::runtime_error If the stream ends before given number of bits.
+     */
+    unsigned int read(int numberOfBits) {
+        assert(numberOfBits >= 0 && numberOfBits <= 32);
+        if (!hasBits(numberOfBits))
+            throw std::runtime_error("Unexpected end of bit stream");
+
+        bitsInBuffer -= numberOfBits;
+        return static_cast<unsigned int>((buffer >> bitsInBuffer) & ((1ULL << numberOfBits) - 1));
+    }
+
+private:
+
+    std::istream& input;
+
+    unsigned long long buffer;
+
+    int bitsInBuffer;
+};
@@ -0,0 +1,45 @@
+#include <ostream>
+#include <cassert>
+
+/**
+Writes values with given number of bits to a binary stream, the most significant bit first.
+The last byte is padded with zeros, as in `Converter::writeBinaryStringToFile`.
+*/
+class BitWriter {
+
+public:
+    explicit BitWriter(std::ostream& output): output(output), buffer(0), bitsInBuffer(0) {}
+
+    /**
+     * Writes `numberOfBits` lower bits of given value, `numberOfBits` must not be more than 32.
+     */
+    void write(unsigned int value, int numberOfBits) {
+        assert(numberOfBits >= 0 && numberOfBits <= 32);
+
+        buffer = (buffer << numberOfBits) | (value & ((1ULL << numberOfBits) - 1));
+        bitsInBuffer += numberOfBits;
+
+        while (bitsInBuffer >= 8) {
+            bitsInBuffer -= 8;
+            output.put(static_cast<char>(buffer >> bitsInBuffer));
+        }
+    }
+
+    /**
+     * Writes the rest of bits, which do not make a whole byte.
+     */
+    void flush() {
+        if (bitsInBuffer > 0)
+            write(0, 8 - bitsInBuffer);
+
+        output.flush();
+    }
+
+private:
+
+    std::ostream& output;
+
+    unsigned long long buffer;
+
+    int bitsInBuffer;
+};
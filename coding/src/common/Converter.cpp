@@ -1,6 +1,7 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <cassert>
 
 #ifndef COMMON_DECLARATIONS
 #define COMMON_DECLARATIONS
@@ -0,0 +1,193 @@
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#ifndef COMMON_DECLARATIONS
+#define COMMON_DECLARATIONS
+
+#include "declarations.cpp"
+
+#endif
+
+/**
+Builds preset dictionaries from samples of data, which will be coded later.
+Samples are split into epochs, and from each epoch the segment is chosen, which covers the most frequent
+substrings of `DMER_LENGTH_TRAINER` characters (d-mers). A d-mer is counted once per sample, so substrings,
+which are repeated in many samples, are preferred to the ones, which are repeated inside one sample.
+Substrings of chosen segments are not counted again, so the dictionary does not repeat itself.
+*/
+class DictionaryTrainer {
+
+public:
+    explicit DictionaryTrainer(int segmentLength = constants::SEGMENT_LENGTH_TRAINER):
+            segmentLength(segmentLength) {
+        assert(segmentLength >= constants::DMER_LENGTH_TRAINER);
+    }
+
+    /**
+    * Returns a dictionary of not more than `dictionarySize` characters. Segments are ordered by their score,
+    * the best ones are at the end, so they are the nearest to the data and survive when the dictionary is cut
+    * to the size of the dictionary of a coder.
+    */
+    CharSequence train(const std::vector<CharSequence>& samples, int dictionarySize) const {
+        std::unordered_map<uint64_t, int> frequencies = countFrequencies(samples);
+
+        size_t corpusSize = 0;
+        for (const CharSequence& sample: samples)
+            corpusSize += sample.size();
+
+        int numberOfEpochs = std::max(1, dictionarySize / segmentLength);
+        size_t epochSize = std::max<size_t>(1, corpusSize / numberOfEpochs);
+
+        std::vector<Segment> segments;
+        size_t epochStart = 0;
+        for (int epoch = 0; epoch < numberOfEpochs && epochStart < corpusSize; ++epoch) {
+            Segment best = bestSegment(samples, epochStart, epochStart + epochSize, frequencies);
+            epochStart += epochSize;
+            if (best.score == 0)
+                continue;
+
+            /// D-mers of the chosen segment are already in the dictionary.
+            const CharSequence& sample = samples[best.sample];
+            for (int position = best.start; position + constants::DMER_LENGTH_TRAINER <= best.end; ++position)
+                frequencies[dmerOf(sample, position)] = 0;
+
+            segments.push_back(best);
+        }
+
+        std::sort(segments.begin(), segments.end(), [](const Segment& first, const Segment& second) {
+            return first.score > second.score;
+        });
+
+        /// The best segments, which fit the dictionary, are written from the end to the start.
+        CharSequence dictionary;
+        int size = 0;
+        std::vector<Segment> chosen;
+        for (const Segment& segment: segments) {
+            if (size + segment.end - segment.start > dictionarySize)
+                continue;
+
+            size += segment.end - segment.start;
+            chosen.push_back(segment);
+        }
+
+        for (int index = static_cast<int>(chosen.size()) - 1; index >= 0; --index) {
+            const CharSequence& sample = samples[chosen[index].sample];
+            dictionary.insert(dictionary.end(), sample.begin() + chosen[index].start,
+                              sample.begin() + chosen[index].end);
+        }
+
+        return dictionary;
+    }
+
+private:
+
+    /**
+    * `Segment` struct contains a part of a sample and the total frequency of its d-mers.
+    */
+    struct Segment {
+        int sample;
+        int start;
+        int end;
+        long long score;
+
+        Segment(int sample, int start, int end, long long score):
+                sample(sample), start(start), end(end), score(score) {}
+    };
+
+    /* Number of characters in a segment, which is added to the dictionary. */
+    int segmentLength;
+
+
+    static uint64_t dmerOf(const CharSequence& sample, int position) {
+        uint64_t dmer = 0;
+        for (int index = 0; index < constants::DMER_LENGTH_TRAINER; ++index)
+            dmer = (dmer << 8) | static_cast<unsigned char>(sample[position + index]);
+
+        return dmer;
+    }
+
+
+    /**
+    * Returns for each d-mer the number of samples, which contain it.
+    */
+    static std::unordered_map<uint64_t, int> countFrequencies(const std::vector<CharSequence>& samples) {
+        std::unordered_map<uint64_t, int> frequencies;
+        std::unordered_map<uint64_t, int> lastSample;
+
+        for (int index = 0; index < static_cast<int>(samples.size()); ++index) {
+            int sampleSize = static_cast<int>(samples[index].size());
+            for (int position = 0; position + constants::DMER_LENGTH_TRAINER <= sampleSize; ++position) {
+                uint64_t dmer = dmerOf(samples[index], position);
+
+                auto last = lastSample.find(dmer);
+                if (last != lastSample.end() && last->second == index)
+                    continue;
+
+                lastSample[dmer] = index;
+                frequencies[dmer]++;
+            }
+        }
+
+        return frequencies;
+    }
+
+
+    /**
+    * Returns the segment with the greatest total frequency of different d-mers among segments,
+    * which start from `from` to `to` in the concatenation of the samples. A segment does not cross samples.
+    */
+    Segment bestSegment(const std::vector<CharSequence>& samples, size_t from, size_t to,
+                        const std::unordered_map<uint64_t, int>& frequencies) const {
+        Segment best(0, 0, 0, 0);
+
+        size_t sampleStart = 0;
+        for (int index = 0; index < static_cast<int>(samples.size()) && sampleStart < to; ++index) {
+            const CharSequence& sample = samples[index];
+            int sampleSize = static_cast<int>(sample.size());
+            size_t sampleEnd = sampleStart + sampleSize;
+            if (sampleEnd <= from || sampleSize < constants::DMER_LENGTH_TRAINER) {
+                sampleStart = sampleEnd;
+                continue;
+            }
+
+            /// Segment is moved by one character, and the number of occurrences of each of its d-mers is kept,
+            /// so the frequency of a d-mer is added only when it appears in the segment for the first time.
+            int length = std::min(segmentLength, sampleSize);
+            int firstStart = static_cast<int>(std::max(from, sampleStart) - sampleStart);
+            int lastStart = std::min(static_cast<int>(std::min(to, sampleEnd) - sampleStart), sampleSize - length);
+            firstStart = std::min(firstStart, lastStart);
+
+            std::unordered_map<uint64_t, int> occurrences;
+            long long score = 0;
+            auto add = [&](int position, int delta) {
+                uint64_t dmer = dmerOf(sample, position);
+                int& count = occurrences[dmer];
+                if ((count == 0 && delta > 0) || (count == 1 && delta < 0)) {
+                    auto frequency = frequencies.find(dmer);
+                    score += delta * (frequency == frequencies.end() ? 0 : frequency->second);
+                }
+                count += delta;
+            };
+
+            for (int position = firstStart; position + constants::DMER_LENGTH_TRAINER <= firstStart + length; ++position)
+                add(position, 1);
+
+            for (int start = firstStart; ; ++start) {
+                if (score > best.score)
+                    best = Segment(index, start, start + length, score);
+                if (start == lastStart)
+                    break;
+
+                add(start, -1);
+                add(start + length - constants::DMER_LENGTH_TRAINER + 1, 1);
+            }
+
+            sampleStart = sampleEnd;
+        }
+
+        return best;
+    }
+};
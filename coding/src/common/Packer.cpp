@@ -1,6 +1,10 @@
 #include <cassert>
+#include <climits>
 #include <bitset>
 #include <math.h>
+#include <fstream>
+#include <sstream>
+#include <functional>
 
 #ifndef CODING_ALGORITHMS
 #define CODING_ALGORITHMS
@@ -11,6 +15,13 @@
 
 #endif
 
+#ifndef BIT_WRITER
+#define BIT_WRITER
+
+#include "BitWriter.cpp"
+
+#endif
+
 #ifndef FILE_CONVERTER
 #define FILE_CONVERTER
 
@@ -33,7 +44,11 @@ public:
      *     - Size N of a dictionary minus 1: 8 bits.
      *     - N notes with structure <number of word (int, 32 bits)><character (8 bits)>.
      *     - Number of codes M (32 bits).
-     *     - M words' indices (each index takes 32 bits).
+     *     - Base B of widths of codes (32 bits): the greatest difference between a code and its number k,
+     *       which is counted from the last `CLEAR_CODE_LZW`.
+     *     - The greatest code L (32 bits).
+     *     - M words' indices, the index with number k takes as many bits as min(B + k, L), so codes widen
+     *       together with the dictionary, which gets a new word after each code until it is full.
      *
      * @param map Dictionary with characters as keys and their codes as values.
      * @param code Total code of a data with given encoding.
@@ -49,13 +64,121 @@ public:
             utils::append(bits, getBinaryString(item.second[0], constants::CHARACTER_BITS_LZW));
 
         utils::append(bits, getBinaryString(static_cast<int>(result.codes.size()), constants::NUMBER_OF_CODES_LZW));
-        for (const int item: result.codes)
-            utils::append(bits, getBinaryString(item, constants::CODES_BITS_PRESENT_LZW));
+
+        /// Words of a preset dictionary are not in the result, so the base is found from the codes.
+        int base = static_cast<int>(result.dictionary.size());
+        int limit = 1;
+        int number = 0;
+        for (int code: result.codes) {
+            base = std::max(base, code - number);
+            limit = std::max(limit, code);
+            number = code == constants::CLEAR_CODE_LZW ? 0 : number + 1;
+        }
+
+        utils::append(bits, getBinaryString(base, constants::CODE_BASE_BITS_LZW));
+        utils::append(bits, getBinaryString(limit, constants::CODE_BASE_BITS_LZW));
+
+        number = 0;
+        for (int code: result.codes) {
+            utils::append(bits, getBinaryString(code, utils::codeBitsLZW(std::min(base + number, limit))));
+            number = code == constants::CLEAR_CODE_LZW ? 0 : number + 1;
+        }
 
         Converter::getInstance().writeBinaryStringToFile(bits, outputFileName);
     }
 
 
+    /**
+     * Writing the result of coding of given stream with LZW. Codes are written as soon as they are made,
+     * so neither the data nor the codes are kept in memory.
+     *
+     * Codes are written as in `writeLZWResult` without the parts before them: the dictionary has all characters,
+     * the base B is `LZWCoder::maxFirstImplicitCode` and L is the max size of the dictionary.
+     */
+    void writeLZWResult(std::istream& input, LZWCoder& coder) {
+        std::ofstream out(outputFileName, std::ios::binary);
+        BitWriter writer(out);
+        std::function<void(int)> write = makeLZWCodeWriter(coder, writer);
+
+        coder.code(input, write);
+
+        writer.flush();
+        out.close();
+    }
+
+
+    /**
+     * Writing the result of coding with LZW with the implicit alphabet. The output is the same as of coding
+     * of a stream, so it has no header.
+     */
+    void writeLZWCodes(const LZWCoder::Result& result, LZWCoder& coder) {
+        assert(coder.hasImplicitAlphabet());
+
+        std::ofstream out(outputFileName, std::ios::binary);
+        BitWriter writer(out);
+        std::function<void(int)> write = makeLZWCodeWriter(coder, writer);
+
+        for (int code: result.codes)
+            write(code);
+
+        writer.flush();
+        out.close();
+    }
+
+
+    /**
+     * Writing the result of coding with LZW by blocks. Blocks are packed in parallel, and the index
+     * tells where each of them starts, so `Unpacker::readLZWBlocks` reads them independently too.
+     *
+     * Parts of output:
+     *     - Number of blocks N (32 bits).
+     *     - Index of N blocks with structure <number of characters (32 bits)><number of codes (32 bits)>
+     *       <offset of the codes in bits from the end of the index (64 bits)>.
+     *     - Codes of N blocks, they are written as in `writeLZWCodes` and each block is padded to a whole byte.
+     *
+     * @param blocks Blocks, which were made by `LZWCoder::codeBlocks`.
+     * @param threads Number of threads, `0` means the number of hardware threads.
+     */
+    void writeLZWBlocks(const std::vector<LZWCoder::Block>& blocks, LZWCoder& coder, int threads = 0) {
+        std::vector<std::string> packed(blocks.size());
+
+        ThreadPool pool(static_cast<int>(std::min<size_t>(threads, blocks.size())));
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            pool.submit([&blocks, &coder, &packed, index] {
+                std::ostringstream part(std::ios::binary);
+                BitWriter writer(part);
+
+                std::function<void(int)> write = makeLZWCodeWriter(coder, writer);
+                for (int code: blocks[index].codes)
+                    write(code);
+
+                writer.flush();
+                packed[index] = part.str();
+            });
+        }
+        pool.wait();
+
+        std::ofstream out(outputFileName, std::ios::binary);
+        BitWriter writer(out);
+
+        writer.write(static_cast<unsigned int>(blocks.size()), constants::BLOCK_HEADER_BITS_LZW);
+        uint64_t offset = 0;
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            writer.write(static_cast<unsigned int>(blocks[index].size), constants::BLOCK_HEADER_BITS_LZW);
+            writer.write(static_cast<unsigned int>(blocks[index].codes.size()), constants::BLOCK_HEADER_BITS_LZW);
+            writer.write(static_cast<unsigned int>(offset >> 32), constants::BLOCK_HEADER_BITS_LZW);
+            writer.write(static_cast<unsigned int>(offset), constants::BLOCK_HEADER_BITS_LZW);
+            offset += static_cast<uint64_t>(packed[index].size()) * CHAR_BIT;
+        }
+
+        /// The index takes whole bytes, so blocks are copied as they are.
+        writer.flush();
+        for (const std::string& part: packed)
+            out.write(part.data(), part.size());
+        out.close();
+    }
+
+
     /**
      * Writing the result of coding with ShannonFano algorithm.
      *
@@ -98,18 +221,116 @@ public:
      * Each triple contain offset (which calculates from right to left), length and character.
      * @param charsInDictionary Max possible number of characters in dictionary.
      * @param charsInBuffer Max possible number of characters in buffer.
+     * @param format Format of triples, triples must be made for it by `LZ77Coder`.
      */
-    void writeTriples(const std::vector<LZ77Coder::Triple>& triples, int charsInDictionary, int charsInBuffer) {
+    void writeTriples(const LZ77Coder::TripleBuffer& triples, int charsInDictionary, int charsInBuffer,
+                      LZ77Coder::TokenFormat format = LZ77Coder::FIXED_WIDTH) {
         CharSequence bits;
-        for (size_t index = 0; index < triples.size(); ++index) {
-            CharSequence codedTriples = combineTriplesIntoBinaryString(triples[index], charsInDictionary, charsInBuffer);
-            bits.insert(bits.end(), codedTriples.begin(), codedTriples.end());
-        }
+        packTriples(triples, charsInDictionary, charsInBuffer, format, bits);
+
+        Converter::getInstance().writeBinaryStringToFile(bits, outputFileName);
+    }
+
+
+    /**
+     * Writing the result of coding with LZ77 together with a header, which describes it,
+     * so `Unpacker` reads it without knowing the parameters of the coder.
+     *
+     * Parts of output:
+     *     - Magic number "LZ77" (32 bits) and version of the header (8 bits).
+     *     - Format of triples (8 bits).
+     *     - Max possible number of characters in dictionary and in buffer (32 bits each).
+     *     - ID of the preset dictionary or 0 (32 bits), which is returned by `LZ77Coder::getDictionaryId`.
+     *     - Number of characters of the original data (64 bits).
+     *     - Triples as they are written by `writeTriples`.
+     *
+     * @param coder Coder, which made the triples.
+     */
+    void writeTriples(const LZ77Coder::TripleBuffer& triples, const LZ77Coder& coder) {
+        uint64_t originalSize = 0;
+        for (const LZ77Coder::Triple& triple: triples)
+            originalSize += triple.length + 1;
 
+        LZ77Coder::StreamHeader header = coder.makeHeader(originalSize);
+        CharSequence bits;
+        auto write = [&](unsigned int value, int numberOfBits) {
+            utils::append(bits, getBinaryString(value, numberOfBits));
+        };
+
+        write(constants::MAGIC_LZ77, constants::MAGIC_BITS_LZ77);
+        write(constants::VERSION_LZ77, constants::VERSION_BITS_LZ77);
+        write(header.format, constants::FORMAT_BITS_LZ77);
+        write(header.dictSize, constants::BLOCK_HEADER_BITS_LZ77);
+        write(header.windowSize - header.dictSize, constants::BLOCK_HEADER_BITS_LZ77);
+        write(header.dictionaryId, constants::DICTIONARY_ID_BITS_LZ77);
+        write(static_cast<unsigned int>(header.originalSize >> 32), constants::BLOCK_HEADER_BITS_LZ77);
+        write(static_cast<unsigned int>(header.originalSize), constants::BLOCK_HEADER_BITS_LZ77);
+
+        packTriples(triples, header.dictSize, header.windowSize - header.dictSize, header.format, bits);
         Converter::getInstance().writeBinaryStringToFile(bits, outputFileName);
     }
 
 
+    /**
+     * Writing the result of coding of given stream with LZ77. Triples are written as soon as they are made,
+     * so neither the data nor the triples are kept in memory. The output is the same as of `writeTriples`.
+     * @param charsInDictionary Max possible number of characters in dictionary.
+     * @param charsInBuffer Max possible number of characters in buffer.
+     * @param format Format of triples, triples must be made for it by `LZ77Coder`, except `ENTROPY_CODED`.
+     */
+    void writeTriples(std::istream& input, const LZ77Coder& coder, int charsInDictionary, int charsInBuffer,
+                      LZ77Coder::TokenFormat format = LZ77Coder::FIXED_WIDTH) {
+        assert(format != LZ77Coder::ENTROPY_CODED);
+
+        std::ofstream out(outputFileName, std::ios::binary);
+        BitWriter writer(out);
+        auto write = [&](unsigned int value, int numberOfBits) { writer.write(value, numberOfBits); };
+
+        coder.code(input, [&](const LZ77Coder::Triple& triple) {
+            packTriple(triple, charsInDictionary, charsInBuffer, format, write);
+        });
+
+        writer.flush();
+        out.close();
+    }
+
+
+    /**
+     * Writing the result of coding with LZ77 by blocks.
+     *
+     * Parts of output:
+     *     - Number of blocks N (32 bits).
+     *     - N blocks with structure <number of characters (32 bits)><number of triples M (32 bits)><M triples>.
+     *
+     * @param blocks Blocks, which were made by `LZ77Coder::codeBlocks`.
+     * @param charsInDictionary Max possible number of characters in dictionary.
+     * @param charsInBuffer Max possible number of characters in buffer.
+     * @param format Format of triples, triples must be made for it by `LZ77Coder`.
+     */
+    void writeBlocks(const std::vector<LZ77Coder::Block>& blocks, int charsInDictionary, int charsInBuffer,
+                     LZ77Coder::TokenFormat format = LZ77Coder::FIXED_WIDTH) {
+        CharSequence bits;
+        auto write = [&](unsigned int value, int numberOfBits) {
+            utils::append(bits, getBinaryString(value, numberOfBits));
+        };
+
+        write(static_cast<unsigned int>(blocks.size()), constants::BLOCK_HEADER_BITS_LZ77);
+        for (const LZ77Coder::Block& block: blocks) {
+            write(block.size, constants::BLOCK_HEADER_BITS_LZ77);
+            write(static_cast<unsigned int>(block.triples.size()), constants::BLOCK_HEADER_BITS_LZ77);
+
+            if (format == LZ77Coder::ENTROPY_CODED) {
+                packEntropyCodedTriples(block.triples, bits);
+                continue;
+            }
+
+            for (const LZ77Coder::Triple& triple: block.triples)
+                packTriple(triple, charsInDictionary, charsInBuffer, format, write);
+        }
+
+        Converter::getInstance().writeBinaryStringToFile(bits, outputFileName);
+    }
+
 private:
 
 
@@ -135,20 +356,202 @@ private:
 
 
     /**
-     * Makes a binary string from given triples.
+     * Makes a function, which writes LZW codes, when the dictionary starts from all characters.
+     * The code with number k since the last clearing takes as many bits as min(B + k, L),
+     * where B is the greatest first code and L is the max size of the dictionary.
      */
-    CharSequence combineTriplesIntoBinaryString(const LZ77Coder::Triple& triple, int charsInDictionary, int charsInBuffer) {
-        int numberOfBitsForOffset = static_cast<int>(ceil(log2(charsInDictionary)));
-        int numberOfBitsForLength = static_cast<int>(ceil(log2(charsInBuffer)));
+    static std::function<void(int)> makeLZWCodeWriter(LZWCoder& coder, BitWriter& writer) {
+        long long base = coder.maxFirstImplicitCode();
+        long long limit = coder.getMaxDictionarySize();
+        long long number = 0;
+
+        return [base, limit, number, &writer](int code) mutable {
+            writer.write(static_cast<unsigned int>(code), utils::codeBitsLZW(std::min(base + number, limit)));
+            number = code == constants::CLEAR_CODE_LZW ? 0 : number + 1;
+        };
+    }
 
-        if (utils::isPowerOfTwo(charsInBuffer))
-            numberOfBitsForLength++;
 
-        CharSequence bits;
-        utils::append(bits, getBinaryString<int>(triple.offset == 0 ? 0 : triple.offset - 1, numberOfBitsForOffset));
-        utils::append(bits, getBinaryString<int>(triple.length, numberOfBitsForLength));
-        utils::append(bits, getBinaryString<char>(triple.character, constants::BITS_PER_CHARACTER_LZ77));
+    /**
+     * Appends given triples in given format to `bits`.
+     */
+    void packTriples(const LZ77Coder::TripleBuffer& triples, int charsInDictionary, int charsInBuffer,
+                     LZ77Coder::TokenFormat format, CharSequence& bits) {
+        auto write = [&](unsigned int value, int numberOfBits) {
+            utils::append(bits, getBinaryString(value, numberOfBits));
+        };
+
+        if (format == LZ77Coder::ENTROPY_CODED) {
+            /// Triples of this format are coded all together, so their number is written before them.
+            write(static_cast<unsigned int>(triples.size()), constants::BLOCK_HEADER_BITS_LZ77);
+            packEntropyCodedTriples(triples, bits);
+        } else {
+            for (const LZ77Coder::Triple& triple: triples)
+                packTriple(triple, charsInDictionary, charsInBuffer, format, write);
+        }
+    }
+
+
+    /**
+     * Writes given triple with `write(value, numberOfBits)`.
+     *
+     * Parts of a triple in `FIXED_WIDTH` format: <offset minus 1><length><character>,
+     * offset of a single character is written as 0.
+     * Parts of a triple in `FLAGGED` format: <flag (1 bit)>[<offset minus 1><length minus min length>]<character>,
+     * the flag is 1 if a match precedes the character.
+     * Parts of a triple in `VARIABLE_LENGTH` format are the same as in `FLAGGED` format, but the offset is written
+     * with Elias delta code, and the length minus min length plus 1 is written with Elias gamma code.
+     */
+    template<class Write>
+    static void packTriple(const LZ77Coder::Triple& triple, int charsInDictionary, int charsInBuffer,
+                           LZ77Coder::TokenFormat format, Write& write) {
+        int numberOfBitsForOffset = utils::offsetBitsLZ77(charsInDictionary);
+        int numberOfBitsForLength = utils::lengthBitsLZ77(charsInBuffer);
+
+        if (format == LZ77Coder::FLAGGED || format == LZ77Coder::VARIABLE_LENGTH) {
+            write(triple.length == 0 ? 0 : 1, 1);
+            if (triple.length > 0) {
+                assert(triple.length >= LZ77Coder::minMatchLength(format));
+                int lengthAboveMin = triple.length - LZ77Coder::minMatchLength(format);
+
+                if (format == LZ77Coder::VARIABLE_LENGTH) {
+                    writeEliasDelta(triple.offset, write);
+                    writeEliasGamma(lengthAboveMin + 1, write);
+                } else {
+                    write(triple.offset - 1, numberOfBitsForOffset);
+                    write(lengthAboveMin, numberOfBitsForLength);
+                }
+            }
+        } else {
+            write(triple.offset == 0 ? 0 : triple.offset - 1, numberOfBitsForOffset);
+            write(triple.length, numberOfBitsForLength);
+        }
+
+        write(static_cast<unsigned char>(triple.character), constants::BITS_PER_CHARACTER_LZ77);
+    }
+
+
+    /**
+     * Writes Elias gamma code of given positive number: zeros, one less than its number of bits, and the number.
+     */
+    template<class Write>
+    static void writeEliasGamma(unsigned int number, Write& write) {
+        int bits = utils::floorLog2(number);
+        write(0, bits);
+        write(number, bits + 1);
+    }
+
+
+    /**
+     * Writes Elias delta code of given positive number: gamma code of its number of bits
+     * and the bits of the number after the leading one. The number may be wider than 32 bits.
+     */
+    template<class Write>
+    static void writeEliasDelta(unsigned long long number, Write& write) {
+        int bits = utils::floorLog2(static_cast<long long>(number));
+        writeEliasGamma(bits + 1, write);
+        writeWide(number, bits, write);
+    }
+
+
+    /**
+     * Writes given number of the low bits of given value with `write`, which takes not more than 32 bits at once.
+     */
+    template<class Write>
+    static void writeWide(unsigned long long value, int numberOfBits, Write& write) {
+        if (numberOfBits > 32) {
+            write(static_cast<unsigned int>(value >> 32), numberOfBits - 32);
+            numberOfBits = 32;
+        }
+
+        write(static_cast<unsigned int>(value), numberOfBits);
+    }
+
+
+    /**
+     * Writes given triples in `ENTROPY_CODED` format.
+     *
+     * Parts of output:
+     *     - Code tables of characters, lengths and offsets, each with structure
+     *       <number of symbols N (9 bits)><N notes <symbol (8 bits)><length of code (8 bits)><code>>.
+     *     - Sizes of coded characters, lengths and offsets in bits (32 bits each).
+     *     - Coded characters, coded lengths and coded offsets.
+     *
+     * The symbol of a length is 0 for a single character, otherwise it is 1 plus the bucket of the length
+     * minus min length plus 1. The symbol of an offset is its bucket. The bucket of a number is its binary logarithm,
+     * and the bits of the number after the leading one are written after the code of the bucket.
+     */
+    void packEntropyCodedTriples(const LZ77Coder::TripleBuffer& triples, CharSequence& bits) {
+        int minLength = LZ77Coder::minMatchLength(LZ77Coder::ENTROPY_CODED);
+
+        CharSequence characters, lengthSymbols, offsetSymbols;
+        for (const LZ77Coder::Triple& triple: triples) {
+            characters.push_back(triple.character);
+            if (triple.length == 0) {
+                lengthSymbols.push_back(0);
+                continue;
+            }
+
+            assert(triple.length >= minLength);
+            lengthSymbols.push_back(static_cast<char>(1 + utils::floorLog2(triple.length - minLength + 1)));
+            offsetSymbols.push_back(static_cast<char>(utils::floorLog2(triple.offset)));
+        }
+
+        std::map<char, CharSequence> characterCodes = makeCodes(characters);
+        std::map<char, CharSequence> lengthCodes = makeCodes(lengthSymbols);
+        std::map<char, CharSequence> offsetCodes = makeCodes(offsetSymbols);
+
+        CharSequence codedCharacters, codedLengths, codedOffsets;
+        for (const LZ77Coder::Triple& triple: triples) {
+            utils::append(codedCharacters, characterCodes[triple.character]);
+            if (triple.length == 0) {
+                utils::append(codedLengths, lengthCodes[0]);
+                continue;
+            }
+
+            int lengthAboveMin = triple.length - minLength + 1;
+            int lengthBucket = utils::floorLog2(lengthAboveMin);
+            utils::append(codedLengths, lengthCodes[static_cast<char>(1 + lengthBucket)]);
+            utils::append(codedLengths, getBinaryString(lengthAboveMin, lengthBucket));
+
+            int offsetBucket = utils::floorLog2(triple.offset);
+            utils::append(codedOffsets, offsetCodes[static_cast<char>(offsetBucket)]);
+            utils::append(codedOffsets, getBinaryString(triple.offset, offsetBucket));
+        }
+
+        for (const std::map<char, CharSequence>* codes: {&characterCodes, &lengthCodes, &offsetCodes}) {
+            int numberOfSymbols = static_cast<int>(codes->size());
+            utils::append(bits, getBinaryString(numberOfSymbols, constants::NUMBER_OF_SYMBOLS_BITS_LZ77));
+            for (const std::pair<char, CharSequence>& item: *codes) {
+                int codeSize = static_cast<int>(item.second.size());
+                utils::append(bits, getBinaryString(item.first, constants::CHAR_LENGTH_BITS_SF));
+                utils::append(bits, getBinaryString(codeSize, constants::CODES_LENGTH_BITS_SF));
+                utils::append(bits, item.second);
+            }
+        }
+
+        for (const CharSequence* stream: {&codedCharacters, &codedLengths, &codedOffsets})
+            utils::append(bits, getBinaryString(static_cast<int>(stream->size()), constants::STREAM_SIZE_BITS_LZ77));
+        for (const CharSequence* stream: {&codedCharacters, &codedLengths, &codedOffsets})
+            utils::append(bits, *stream);
+    }
+
+
+    /**
+     * Makes Shannon-Fano codes of given symbols. If there is only one symbol, its code is `0`,
+     * so that every symbol takes place in the coded stream.
+     */
+    std::map<char, CharSequence> makeCodes(const CharSequence& symbols) {
+        std::map<char, CharSequence> codes;
+        if (symbols.empty())
+            return codes;
+
+        if (std::count(symbols.begin(), symbols.end(), symbols[0]) == static_cast<long>(symbols.size())) {
+            codes[symbols[0]] = CharSequence{'0'};
+            return codes;
+        }
 
-        return bits;
+        ShannonFanoCoder coder(symbols);
+        return coder.code(symbols).asMap();
     }
-};
+};
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <exception>
+
+/**
+Fixed set of threads, which run submitted tasks in the order of submission.
+*/
+class ThreadPool {
+
+public:
+    /**
+    * Creates a pool with given number of threads, `0` means the number of hardware threads.
+    */
+    explicit ThreadPool(int threads) {
+        if (threads <= 0)
+            threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+        for (int index = 0; index < threads; ++index)
+            workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+
+    ~ThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            isStopped = true;
+        }
+
+        taskAdded.notify_all();
+        for (std::thread& worker: workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            tasks.push(task);
+            unfinished++;
+        }
+
+        taskAdded.notify_one();
+    }
+
+    /**
+    * Blocks until all submitted tasks are finished.
+    * @throws The first exception, which was thrown by a task since the previous call, other tasks are still run.
+    */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        allFinished.wait(lock, [this] { return unfinished == 0; });
+
+        if (error) {
+            std::exception_ptr thrown = error;
+            error = nullptr;
+            std::rethrow_exception(thrown);
+        }
+    }
+
+    int size() const {
+        return static_cast<int>(workers.size());
+    }
+
+private:
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+
+    std::mutex mutex;
+    std::condition_variable taskAdded;
+    std::condition_variable allFinished;
+
+    /* Number of tasks which are waiting in the queue or running. */
+    int unfinished = 0;
+
+    bool isStopped = false;
+
+    /* The first exception of a task, which has not been thrown by `wait` yet. */
+    std::exception_ptr error;
+
+
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskAdded.wait(lock, [this] { return isStopped || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+
+                task = tasks.front();
+                tasks.pop();
+            }
+
+            std::exception_ptr thrown;
+            try {
+                task();
+            } catch (...) {
+                thrown = std::current_exception();
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (thrown && !error)
+                error = thrown;
+            if (--unfinished == 0)
+                allFinished.notify_all();
+        }
+    }
+};
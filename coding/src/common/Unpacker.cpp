@@ -1,6 +1,12 @@
 #include <string>
 #include <bitset>
+#include <climits>
 #include <math.h>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
 
 #ifndef CODING_ALGORITHMS
 #define CODING_ALGORITHMS
@@ -11,6 +17,13 @@
 
 #endif
 
+#ifndef BIT_READER
+#define BIT_READER
+
+#include "BitReader.cpp"
+
+#endif
+
 #ifndef FILE_CONVERTER
 #define FILE_CONVERTER
 
@@ -44,15 +57,104 @@ public:
         std::vector<int> codes(codesSize);
         pointer += constants::NUMBER_OF_CODES_LZW;
 
+        int base = unpackBits(bits, pointer, constants::CODE_BASE_BITS_LZW);
+        int limit = unpackBits(bits, pointer + constants::CODE_BASE_BITS_LZW, constants::CODE_BASE_BITS_LZW);
+        pointer += 2 * constants::CODE_BASE_BITS_LZW;
+
+        /// Number of the code since the last clearing of the dictionary.
+        int number = 0;
         for (int numberOfCodes = 0; numberOfCodes < codesSize; ++numberOfCodes) {
-            codes[numberOfCodes] = unpackBits(bits, pointer, constants::CODES_BITS_PRESENT_LZW);
-            pointer += constants::CODES_BITS_PRESENT_LZW;
+            int codeBits = utils::codeBitsLZW(std::min(base + number, limit));
+            codes[numberOfCodes] = unpackBits(bits, pointer, codeBits);
+            pointer += codeBits;
+            number = codes[numberOfCodes] == constants::CLEAR_CODE_LZW ? 0 : number + 1;
         }
 
         return LZWCoder::Result(dictionary, codes);
     }
 
 
+    /**
+     * Reading LZWCoder output, which was written by `Packer::writeLZWResult` from a stream, and writing
+     * the encoded data to given stream. Codes are encoded as soon as they are read.
+     */
+    void readLZWResult(std::ostream& output, LZWCoder& coder) {
+        std::ifstream in(sourceFileName, std::ios::binary);
+        BitReader reader(in);
+        std::function<bool(int&)> read = makeLZWCodeReader(coder, reader);
+
+        coder.encode(read, output);
+
+        in.close();
+    }
+
+
+    /**
+     * Reading LZWCoder output of coding with the implicit alphabet or of coding of a stream.
+     * @return The result of coding without a dictionary of characters.
+     */
+    LZWCoder::Result readLZWCodes(LZWCoder& coder) {
+        std::ifstream in(sourceFileName, std::ios::binary);
+        BitReader reader(in);
+        std::function<bool(int&)> read = makeLZWCodeReader(coder, reader);
+
+        LZWCoder::Result result;
+        int code;
+        while (read(code))
+            result.codes.push_back(code);
+
+        in.close();
+        return result;
+    }
+
+
+    /**
+     * Reading LZWCoder output, which was written by blocks. Each block is read from its offset in the index
+     * by its own reader, so blocks are read in parallel.
+     * @param threads Number of threads, `0` means the number of hardware threads.
+     * @return Blocks with codes, which are encoded by `LZWCoder::encode`.
+     * @throws std::runtime_error If the file ends before the codes of a block.
+     */
+    std::vector<LZWCoder::Block> readLZWBlocks(LZWCoder& coder, int threads = 0) {
+        std::ifstream in(sourceFileName, std::ios::binary);
+        BitReader reader(in);
+
+        std::vector<LZWCoder::Block> blocks(reader.read(constants::BLOCK_HEADER_BITS_LZW));
+        std::vector<uint64_t> offsets(blocks.size());
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            blocks[index].size = static_cast<int>(reader.read(constants::BLOCK_HEADER_BITS_LZW));
+            blocks[index].codes.resize(reader.read(constants::BLOCK_HEADER_BITS_LZW));
+
+            uint64_t highBits = reader.read(constants::BLOCK_HEADER_BITS_LZW);
+            offsets[index] = (highBits << 32) | reader.read(constants::BLOCK_HEADER_BITS_LZW);
+        }
+        in.close();
+
+        /// The number of blocks and 4 fields of each block.
+        uint64_t indexBits = static_cast<uint64_t>(constants::BLOCK_HEADER_BITS_LZW) * (1 + 4 * blocks.size());
+
+        ThreadPool pool(static_cast<int>(std::min<size_t>(threads, blocks.size())));
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            pool.submit([this, &coder, &blocks, &offsets, indexBits, index] {
+                uint64_t start = indexBits + offsets[index];
+                std::ifstream part(sourceFileName, std::ios::binary);
+                part.seekg(static_cast<std::streamoff>(start / CHAR_BIT));
+                BitReader reader(part);
+                reader.read(static_cast<int>(start % CHAR_BIT));
+
+                std::function<bool(int&)> read = makeLZWCodeReader(coder, reader);
+                for (int& code: blocks[index].codes) {
+                    if (!read(code))
+                        throw std::runtime_error("Unexpected end of file: " + sourceFileName);
+                }
+            });
+        }
+
+        pool.wait();
+        return blocks;
+    }
+
+
     ShannonFanoCoder::Result readShannonFanoResult() {
         CharSequence bits = readOrigin();
         assert(bits.size() > 0);
@@ -86,41 +188,166 @@ public:
      * Reading LZ77Coder output.
      * @param charsInDictionary Max possible number of characters in dictionary.
      * @param charsInBuffer Max possible number of characters in buffer.
+     * @param format Format, which triples were written in.
      * @return An array with triples, which are used in LZ77 algorithm to save the result of coding.
      */
-    std::vector<LZ77Coder::Triple> readTriples(int charsInDictionary, int charsInBuffer) {
+    LZ77Coder::TripleBuffer readTriples(int charsInDictionary, int charsInBuffer,
+                                        LZ77Coder::TokenFormat format = LZ77Coder::FIXED_WIDTH) {
         CharSequence bits = readOrigin();
         assert(bits.size() > 0);
 
-        int numberOfBitsForOffset = static_cast<int>(ceil(log2(charsInDictionary)));
-        int numberOfBitsForLength = static_cast<int>(ceil(log2(charsInBuffer)));
-        if (utils::isPowerOfTwo(charsInBuffer))
-            numberOfBitsForLength++;
+        int pointer = 0;
+        return unpackTriples(bits, pointer, charsInDictionary, charsInBuffer, format);
+    }
 
-        int step = numberOfBitsForLength + numberOfBitsForOffset + constants::BITS_PER_CHARACTER_LZ77;
 
-        int bitsSize = static_cast<int>(bits.size());
-        std::vector<LZ77Coder::Triple> encodedInfo;
-        for (int index = 0; index + numberOfBitsForLength + numberOfBitsForOffset < bitsSize; index += step) {
-            int unpackedOffset = unpackBits(bits, index, numberOfBitsForOffset);
-            int unpackedLength = unpackBits(bits, index + numberOfBitsForOffset, numberOfBitsForLength);
-            unpackedOffset = unpackedOffset == 0 && unpackedLength == 0 ? unpackedOffset : unpackedOffset + 1;
-            int unpackedCharacter = unpackBits(bits, index + numberOfBitsForLength +
-                                               numberOfBitsForOffset, constants::BITS_PER_CHARACTER_LZ77);
+    /**
+     * Reading LZ77Coder output, which was written with a header by `Packer::writeTriples`.
+     * Triples are read until they cover the original data, so padding is never taken for a triple.
+     * @param header The header of the triples, which tells how to encode them with `LZ77Coder(header)`.
+     * @return An array with triples, which are used in LZ77 algorithm to save the result of coding.
+     * @throws std::runtime_error If the file is not written by `Packer::writeTriples`, has another version
+     * of the header or is truncated, or if its triples do not cover the original data exactly.
+     */
+    LZ77Coder::TripleBuffer readTriples(LZ77Coder::StreamHeader& header) {
+        CharSequence bits = readOrigin();
 
-            encodedInfo.push_back(LZ77Coder::Triple(unpackedOffset, unpackedLength, unpackedCharacter));
+        int pointer = 0;
+        auto read = [&](int numberOfBits) {
+            pointer += numberOfBits;
+            return unpackBits(bits, pointer - numberOfBits, numberOfBits);
+        };
+
+        if (read(constants::MAGIC_BITS_LZ77) != constants::MAGIC_LZ77)
+            throw std::runtime_error("Not LZ77 triples with a header: " + sourceFileName);
+        if (read(constants::VERSION_BITS_LZ77) != constants::VERSION_LZ77)
+            throw std::runtime_error("Unknown version of the LZ77 header: " + sourceFileName);
+
+        int format = read(constants::FORMAT_BITS_LZ77);
+        header.dictSize = read(constants::BLOCK_HEADER_BITS_LZ77);
+        int charsInBuffer = read(constants::BLOCK_HEADER_BITS_LZ77);
+        header.dictionaryId = static_cast<uint32_t>(read(constants::DICTIONARY_ID_BITS_LZ77));
+        uint64_t highBits = static_cast<uint32_t>(read(constants::BLOCK_HEADER_BITS_LZ77));
+        header.originalSize = (highBits << 32) | static_cast<uint32_t>(read(constants::BLOCK_HEADER_BITS_LZ77));
+
+        if (format > LZ77Coder::ENTROPY_CODED || header.dictSize <= 0 || charsInBuffer <= 0 ||
+            charsInBuffer > INT_MAX - header.dictSize)
+            throw std::runtime_error("Wrong parameters in the LZ77 header: " + sourceFileName);
+        header.format = static_cast<LZ77Coder::TokenFormat>(format);
+        header.windowSize = header.dictSize + charsInBuffer;
+
+        LZ77Coder::TripleBuffer encodedInfo;
+        uint64_t size = 0;
+        if (header.format == LZ77Coder::ENTROPY_CODED) {
+            encodedInfo = unpackTriples(bits, pointer, header.dictSize, charsInBuffer, header.format);
+            for (const LZ77Coder::Triple& triple: encodedInfo)
+                size += triple.length + 1;
+        } else {
+            /// `read` throws at the end of the bits, so a truncated file is never read past its end.
+            while (size < header.originalSize) {
+                LZ77Coder::Triple triple = unpackTriple(header.dictSize, charsInBuffer, header.format, read);
+                encodedInfo.push_back(triple);
+                size += triple.length + 1;
+            }
         }
 
+        if (size != header.originalSize)
+            throw std::runtime_error("LZ77 triples do not match the size in the header: " + sourceFileName);
         return encodedInfo;
     }
 
 
+    /**
+     * Reading LZ77Coder output and writing the encoded data to given stream. Triples are encoded
+     * as soon as they are read, so neither the triples nor the data are kept in memory.
+     * @param charsInDictionary Max possible number of characters in dictionary.
+     * @param charsInBuffer Max possible number of characters in buffer.
+     * @param format Format, which triples were written in, except `ENTROPY_CODED`.
+     * @throws std::runtime_error If the file ends inside a triple, or a match is not in the dictionary.
+     */
+    void readTriples(std::ostream& output, const LZ77Coder& coder, int charsInDictionary, int charsInBuffer,
+                     LZ77Coder::TokenFormat format = LZ77Coder::FIXED_WIDTH) {
+        assert(format != LZ77Coder::ENTROPY_CODED);
+
+        std::ifstream in(sourceFileName, std::ios::binary);
+        BitReader reader(in);
+        auto read = [&](int numberOfBits) { return static_cast<int>(reader.read(numberOfBits)); };
+
+        coder.encode([&](LZ77Coder::Triple& triple) {
+            if (!reader.hasBits(constants::BITS_PER_CHARACTER_LZ77))
+                return false;
+
+            triple = unpackTriple(charsInDictionary, charsInBuffer, format, read);
+            return true;
+        }, output);
+
+        in.close();
+    }
+
+
+    /**
+     * Reading LZ77Coder output, which was written by blocks.
+     * @param charsInDictionary Max possible number of characters in dictionary.
+     * @param charsInBuffer Max possible number of characters in buffer.
+     * @param format Format, which triples were written in.
+     * @return Blocks with triples, which are used in LZ77 algorithm to save the result of coding.
+     */
+    std::vector<LZ77Coder::Block> readBlocks(int charsInDictionary, int charsInBuffer,
+                                             LZ77Coder::TokenFormat format = LZ77Coder::FIXED_WIDTH) {
+        CharSequence bits = readOrigin();
+        assert(bits.size() > 0);
+
+        int pointer = 0;
+        auto read = [&](int numberOfBits) {
+            pointer += numberOfBits;
+            return unpackBits(bits, pointer - numberOfBits, numberOfBits);
+        };
+
+        std::vector<LZ77Coder::Block> blocks(read(constants::BLOCK_HEADER_BITS_LZ77));
+        for (LZ77Coder::Block& block: blocks) {
+            block.size = read(constants::BLOCK_HEADER_BITS_LZ77);
+            int numberOfTriples = read(constants::BLOCK_HEADER_BITS_LZ77);
+
+            if (format == LZ77Coder::ENTROPY_CODED) {
+                unpackEntropyCodedTriples(bits, pointer, numberOfTriples, block.triples);
+                continue;
+            }
+
+            for (int index = 0; index < numberOfTriples; ++index)
+                block.triples.push_back(unpackTriple(charsInDictionary, charsInBuffer, format, read));
+        }
+
+        return blocks;
+    }
+
+
 private:
 
 
     std::string sourceFileName;
 
 
+    /**
+     * Makes a function, which reads LZW codes written by `Packer::makeLZWCodeWriter`, while they are left.
+     */
+    static std::function<bool(int&)> makeLZWCodeReader(LZWCoder& coder, BitReader& reader) {
+        long long base = coder.maxFirstImplicitCode();
+        long long limit = coder.getMaxDictionarySize();
+        long long number = 0;
+
+        return [base, limit, number, &reader](int& code) mutable {
+            /// Padding of the last byte is shorter than any code.
+            int codeBits = utils::codeBitsLZW(std::min(base + number, limit));
+            if (!reader.hasBits(codeBits))
+                return false;
+
+            code = static_cast<int>(reader.read(codeBits));
+            number = code == constants::CLEAR_CODE_LZW ? 0 : number + 1;
+            return true;
+        };
+    }
+
+
     /**
      * Read a content of a binary file.
      * @return String with data from a binary file.
@@ -142,16 +369,192 @@ private:
 
     /**
      * Converts given binary sequence into integer.
+     * @throws std::runtime_error If the sequence ends before `start + length`.
      */
     int unpackBits(const CharSequence& bits, int start, int length) {
-        int value = 0;
+        if (start < 0 || static_cast<size_t>(start) + length > bits.size())
+            throw std::runtime_error("Unexpected end of file: " + sourceFileName);
+
+        unsigned int value = 0;
 
         for (int index = length - 1; index >= 0; --index) {
             if (bits[start + length - 1 - index] == '1') {
-                value |= (1 << index);
+                value |= (1u << index);
+            }
+        }
+
+        return static_cast<int>(value);
+    }
+
+
+    /**
+     * Reads triples, which were written by `Packer::packTriples`, starting from `pointer` till the end of `bits`.
+     */
+    LZ77Coder::TripleBuffer unpackTriples(const CharSequence& bits, int& pointer, int charsInDictionary,
+                                          int charsInBuffer, LZ77Coder::TokenFormat format) {
+        auto read = [&](int numberOfBits) {
+            pointer += numberOfBits;
+            return unpackBits(bits, pointer - numberOfBits, numberOfBits);
+        };
+
+        LZ77Coder::TripleBuffer encodedInfo;
+        if (format == LZ77Coder::ENTROPY_CODED) {
+            int numberOfTriples = read(constants::BLOCK_HEADER_BITS_LZ77);
+            unpackEntropyCodedTriples(bits, pointer, numberOfTriples, encodedInfo);
+            return encodedInfo;
+        }
+
+        /// Padding of the last byte is shorter than a character, so there is one more triple while a byte is left.
+        int bitsSize = static_cast<int>(bits.size());
+        while (pointer + constants::BITS_PER_CHARACTER_LZ77 <= bitsSize)
+            encodedInfo.push_back(unpackTriple(charsInDictionary, charsInBuffer, format, read));
+
+        return encodedInfo;
+    }
+
+
+    /**
+     * Reads a triple with `read(numberOfBits)`, the triple must be written by `Packer::packTriple`.
+     */
+    template<class Read>
+    static LZ77Coder::Triple unpackTriple(int charsInDictionary, int charsInBuffer, LZ77Coder::TokenFormat format,
+                                          Read& read) {
+        int numberOfBitsForOffset = utils::offsetBitsLZ77(charsInDictionary);
+        int numberOfBitsForLength = utils::lengthBitsLZ77(charsInBuffer);
+
+        long long unpackedOffset = 0;
+        int unpackedLength = 0;
+        if (format == LZ77Coder::FLAGGED) {
+            if (read(1) == 1) {
+                unpackedOffset = read(numberOfBitsForOffset) + 1;
+                unpackedLength = read(numberOfBitsForLength) + LZ77Coder::minMatchLength(format);
+            }
+        } else if (format == LZ77Coder::VARIABLE_LENGTH) {
+            if (read(1) == 1) {
+                unpackedOffset = readEliasDelta(read);
+                unpackedLength = readEliasGamma(read) - 1 + LZ77Coder::minMatchLength(format);
             }
+        } else {
+            unpackedOffset = read(numberOfBitsForOffset);
+            unpackedLength = read(numberOfBitsForLength);
+            unpackedOffset = unpackedOffset == 0 && unpackedLength == 0 ? unpackedOffset : unpackedOffset + 1;
+        }
+
+        char unpackedCharacter = static_cast<char>(read(constants::BITS_PER_CHARACTER_LZ77));
+        return LZ77Coder::Triple(unpackedOffset, unpackedLength, unpackedCharacter);
+    }
+
+
+    template<class Read>
+    static int readEliasGamma(Read& read) {
+        int bits = 0;
+        while (read(1) == 0) {
+            if (++bits >= 31)
+                throw std::runtime_error("Too long Elias gamma code");
+        }
+
+        return (1 << bits) | read(bits);
+    }
+
+
+    template<class Read>
+    static long long readEliasDelta(Read& read) {
+        int bits = readEliasGamma(read) - 1;
+        if (bits >= 63)
+            throw std::runtime_error("Too long Elias delta code");
+        return (1LL << bits) | readWide(read, bits);
+    }
+
+
+    /**
+     * Reads given number of bits with `read`, which returns not more than 31 bits at once.
+     */
+    template<class Read>
+    static long long readWide(Read& read, int numberOfBits) {
+        long long value = 0;
+        for (; numberOfBits > 0; numberOfBits -= 30) {
+            int part = std::min(numberOfBits, 30);
+            value = (value << part) | read(part);
         }
 
         return value;
     }
-};
+
+
+    /**
+     * Reads given number of triples, which were written by `Packer::packEntropyCodedTriples`,
+     * and moves `pointer` after them.
+     */
+    void unpackEntropyCodedTriples(const CharSequence& bits, int& pointer, int numberOfTriples,
+                                   LZ77Coder::TripleBuffer& triples) {
+        std::vector<ShannonFanoCoder::Tree> trees;
+        for (int stream = 0; stream < 3; ++stream) {
+            int numberOfSymbols = unpackBits(bits, pointer, constants::NUMBER_OF_SYMBOLS_BITS_LZ77);
+            pointer += constants::NUMBER_OF_SYMBOLS_BITS_LZ77;
+
+            std::map<char, CharSequence> codes;
+            for (int index = 0; index < numberOfSymbols; ++index) {
+                char symbol = unpackBits(bits, pointer, constants::CHAR_LENGTH_BITS_SF);
+                int codeSize = unpackBits(bits, pointer + constants::CHAR_LENGTH_BITS_SF,
+                                          constants::CODES_LENGTH_BITS_SF);
+                pointer += constants::CHAR_LENGTH_BITS_SF + constants::CODES_LENGTH_BITS_SF;
+
+                codes[symbol] = utils::subsequence(bits, pointer, codeSize);
+                pointer += codeSize;
+            }
+
+            trees.push_back(ShannonFanoCoder::makeTree(codes));
+        }
+
+        int charactersPointer = pointer + 3 * constants::STREAM_SIZE_BITS_LZ77;
+        int lengthsPointer = charactersPointer + unpackBits(bits, pointer, constants::STREAM_SIZE_BITS_LZ77);
+        int offsetsPointer = lengthsPointer + unpackBits(bits, pointer + constants::STREAM_SIZE_BITS_LZ77,
+                                                         constants::STREAM_SIZE_BITS_LZ77);
+        pointer = offsetsPointer + unpackBits(bits, pointer + 2 * constants::STREAM_SIZE_BITS_LZ77,
+                                              constants::STREAM_SIZE_BITS_LZ77);
+
+        auto readOffset = [&](int numberOfBits) {
+            int value = unpackBits(bits, offsetsPointer, numberOfBits);
+            offsetsPointer += numberOfBits;
+            return value;
+        };
+
+        int minLength = LZ77Coder::minMatchLength(LZ77Coder::ENTROPY_CODED);
+        for (int index = 0; index < numberOfTriples; ++index) {
+            long long offset = 0;
+            int length = 0;
+
+            int lengthSymbol = unpackSymbol(bits, lengthsPointer, trees[1]);
+            if (lengthSymbol > 0) {
+                int lengthBucket = lengthSymbol - 1;
+                length = ((1 << lengthBucket) | unpackBits(bits, lengthsPointer, lengthBucket)) - 1 + minLength;
+                lengthsPointer += lengthBucket;
+
+                int offsetBucket = unpackSymbol(bits, offsetsPointer, trees[2]);
+                if (offsetBucket >= 63)
+                    throw std::runtime_error("Wrong bucket of an LZ77 offset");
+                offset = (1LL << offsetBucket) | readWide(readOffset, offsetBucket);
+            }
+
+            char character = static_cast<char>(unpackSymbol(bits, charactersPointer, trees[0]));
+            triples.push_back(LZ77Coder::Triple(offset, length, character));
+        }
+    }
+
+
+    /**
+     * Reads a symbol with given tree of Shannon-Fano codes and moves `pointer` after its code.
+     */
+    int unpackSymbol(const CharSequence& bits, int& pointer, const ShannonFanoCoder::Tree& tree) {
+        int node = ShannonFanoCoder::Tree::ROOT;
+        while (!tree[node].isLeaf()) {
+            if (static_cast<size_t>(pointer) >= bits.size())
+                throw std::runtime_error("Unexpected end of file: " + sourceFileName);
+            node = tree.next(node, bits[pointer++]);
+            if (node < 0)
+                throw std::runtime_error("Unknown Shannon-Fano code: " + sourceFileName);
+        }
+
+        return static_cast<unsigned char>(tree[node].value);
+    }
+};
\ No newline at end of file
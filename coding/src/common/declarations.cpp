@@ -1,4 +1,6 @@
 #include <vector>
+#include <climits>
+#include <cstdint>
 
 using CharSequence = std::vector<char>;
 
@@ -13,11 +15,83 @@ namespace utils {
     }
 
     static bool isPowerOfTwo(int number) {
+        if (number <= 0)
+            return false;
+
         while (number % 2 == 0)
             number /= 2;
         return number == 1;
     }
 
+    /**
+     * Returns the least number of bits `n`, such that 2^n is not less than given number.
+     */
+    static int ceilLog2(long long number) {
+        int bits = 0;
+        while ((1LL << bits) < number)
+            bits++;
+
+        return bits;
+    }
+
+    /**
+     * Returns the greatest number of bits `n`, such that 2^n is not more than given positive number.
+     */
+    static int floorLog2(long long number) {
+        int bits = 0;
+        while ((number >> (bits + 1)) > 0)
+            bits++;
+
+        return bits;
+    }
+
+    /**
+     * Returns number of bits of Elias gamma code of given positive number.
+     */
+    static int eliasGammaBits(long long number) {
+        return 2 * floorLog2(number) + 1;
+    }
+
+    /**
+     * Returns number of bits of Elias delta code of given positive number: gamma code of its length in bits
+     * and the bits after the leading one.
+     */
+    static int eliasDeltaBits(long long number) {
+        return eliasGammaBits(floorLog2(number) + 1) + floorLog2(number);
+    }
+
+    /**
+     * Returns number of bits for offsets of LZ77 triples, which are written with fixed width.
+     */
+    static int offsetBitsLZ77(int charsInDictionary) {
+        return ceilLog2(charsInDictionary);
+    }
+
+    /**
+     * Returns number of bits for lengths of LZ77 triples, which are written with fixed width.
+     */
+    static int lengthBitsLZ77(int charsInBuffer) {
+        return isPowerOfTwo(charsInBuffer) ? ceilLog2(charsInBuffer) + 1 : ceilLog2(charsInBuffer);
+    }
+
+    /**
+     * Returns number of bits for LZW codes, which are not greater than given positive number.
+     */
+    static int codeBitsLZW(long long maxCode) {
+        return floorLog2(maxCode) + 1;
+    }
+
+    /**
+     * Returns 32-bit FNV-1a hash of given characters.
+     */
+    static uint32_t fnvHash(const CharSequence &source) {
+        uint32_t hash = 2166136261u;
+        for (char character: source)
+            hash = (hash ^ static_cast<unsigned char>(character)) * 16777619u;
+
+        return hash;
+    }
+
 }
 
 namespace constants {
@@ -28,10 +102,43 @@ namespace constants {
     const int TOTAL_CODE_LENGTH_BITS_SF = 32;
 
     const int BITS_PER_CHARACTER_LZ77 = 8;
+    const int HASH_BYTES_LZ77 = 3;
+    const int HASH_BITS_LZ77 = 16;
+    const int SEARCH_DEPTH_LZ77 = 4096;
+    const int NICE_LENGTH_LZ77 = INT_MAX;
+    const int BINARY_TREE_HASH_BYTES_LZ77 = 4;
+    const int BINARY_TREE_HASH_BITS_LZ77 = 24;
+    const int OPTIMUM_WINDOW_LZ77 = 1 << 16;
+    const int OPTIMUM_NICE_LENGTH_LZ77 = 256;
+    const int BLOCK_HEADER_BITS_LZ77 = 32;
+    const int WIDE_COPY_SLACK_LZ77 = 32;
+    const int STREAM_CHUNK_LZ77 = 1 << 16;
+    const int MIN_MATCH_LENGTH_FLAGGED_LZ77 = 3;
+    const int NUMBER_OF_SYMBOLS_BITS_LZ77 = 9;
+    const int STREAM_SIZE_BITS_LZ77 = 32;
+    const int DICTIONARY_ID_BITS_LZ77 = 32;
+    const int LONG_DISTANCE_WINDOW_LZ77 = 64;
+    const int LONG_DISTANCE_ANCHOR_BITS_LZ77 = 6;
+    const int LONG_DISTANCE_MIN_LENGTH_LZ77 = 64;
+    const int MIN_LEVEL_LZ77 = 1;
+    const int MAX_LEVEL_LZ77 = 9;
+    const int MAGIC_LZ77 = 0x4C5A3737;
+    const int MAGIC_BITS_LZ77 = 32;
+    const int VERSION_LZ77 = 1;
+    const int VERSION_BITS_LZ77 = 8;
+    const int FORMAT_BITS_LZ77 = 8;
 
     const int DICTIONARY_SIZE_LZW = 8;
     const int CHARACTER_BITS_LZW = 8;
     const int NUMBER_OF_CODES_LZW = 32;
-    const int CODES_BITS_PRESENT_LZW = 32;
+    const int CODE_BASE_BITS_LZW = 32;
+    const int INITIAL_TABLE_SIZE_LZW = 1 << 12;
+    const int CLEAR_CODE_LZW = 0;
+    const int MONITOR_GAP_LZW = 10000;
+    const int STREAM_CHUNK_LZW = 1 << 16;
+    const int BLOCK_HEADER_BITS_LZW = 32;
+
+    const int SEGMENT_LENGTH_TRAINER = 128;
+    const int DMER_LENGTH_TRAINER = 6;
 
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <iomanip>
 #include <cmath>
 #include <vector>
+#include <string>
+#include <cstring>
 #include <sys/stat.h>
 
 #ifndef TIME_MEASUREMENT
@@ -55,12 +57,7 @@ class Experimenter {
             "12.txt"
     };
 
-    const std::vector<std::string> overallHeadings{"S1", "H",
-                                                   "SF_S2", "SF_K", "SF_TU", "SF_TP",
-                                                   "LZ77_5_S2", "LZ77_5_K", "LZ77_5_TU", "LZ77_5_TP",
-                                                   "LZ77_10_S2", "LZ77_10_K", "LZ77_10_TU", "LZ77_10_TP",
-                                                   "LZ77_20_S2", "LZ77_20_K", "LZ77_20_TU", "LZ77_20_TP",
-                                                   "LZW_S2", "LZW_K", "LZW_TU", "LZW_TP"};
+    const std::vector<std::string> overallHeadings = makeOverallHeadings();
 
 public:
 
@@ -92,7 +89,7 @@ public:
             ShannonFanoCoder::Result unpackedResult = unpacker->readShannonFanoResult();
             std::cout << "[Shannon-Fano] Read packed data\n";
 
-            std::shared_ptr<ShannonFanoCoder::Node> tree = ShannonFanoCoder::makeTree(unpackedResult.asMap());
+            ShannonFanoCoder::Tree tree = ShannonFanoCoder::makeTree(unpackedResult.asMap());
 
             std::string resultFileName = path + this->cutExtension(fileName) + ".unshan";
             /// Creating new file with the result of encoding.
@@ -101,117 +98,6 @@ public:
             std::cout << "[Shannon-Fano] Decoded and made new file with the result\n\n";
         };
 
-        std::function<void(std::string)> lz77_5_Coding = [this, path](std::string sourceFileName) {
-            std::cout << "[LZ77-5] Preparing packer and getting source\n";
-
-            std::string outputFile = path + this->cutExtension(sourceFileName) + ".lz775";
-            Packer* packer = new Packer(outputFile);
-            CharSequence data = Converter::getInstance().readBinaryFile(path + sourceFileName);
-
-            int dictSize = 4 * 1024;
-            int windowSize = 5 * 1024;
-            LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
-
-            std::cout << "[LZ77-5] Starting coding\n";
-            std::vector<LZ77Coder::Triple> codedInfo = coder->code(data);
-            std::cout << "[LZ77-5] Have finished coding\n";
-
-            packer->writeTriples(codedInfo, dictSize, windowSize - dictSize);
-            std::cout << "[LZ77-5] Finished writing result to file\n";
-        };
-
-        std::function<void(std::string)> lz77_5_Decoding = [this, path](std::string fileName) {
-            std::string sourceFile = path + this->cutExtension(fileName) + ".lz775";
-            Unpacker* unpacker = new Unpacker(sourceFile);
-
-            int dictSize = 4 * 1024;
-            int windowSize = 5 * 1024;
-            LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
-
-            std::vector<LZ77Coder::Triple> unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
-            std::cout << "[LZ77-5] Read packed data\n";
-
-            /// Creating new file with the result of encoding.
-            std::string resultFileName = path + this->cutExtension(fileName) + ".unlz775";
-            Converter::getInstance().writeCharSequenceToABinaryFile(resultFileName,
-                                                                    coder->encode(unpacked));
-            std::cout << "[LZ77-5] Decoded and made new file with the result\n\n";
-        };
-
-        std::function<void(std::string)> lz77_10_Coding = [this, path](std::string sourceFileName) {
-            std::cout << "[LZ77-10] Preparing packer and getting source\n";
-
-            std::string outputFile = path + this->cutExtension(sourceFileName) + ".lz7710";
-            Packer* packer = new Packer(outputFile);
-            CharSequence data = Converter::getInstance().readBinaryFile(path + sourceFileName);
-
-            int dictSize = 8 * 1024;
-            int windowSize = 10 * 1024;
-            LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
-
-            std::cout << "[LZ77-10] Starting coding\n";
-            std::vector<LZ77Coder::Triple> codedInfo = coder->code(data);
-            std::cout << "[LZ77-10] Have finished coding\n";
-
-            packer->writeTriples(codedInfo, dictSize, windowSize - dictSize);
-            std::cout << "[LZ77-10] Finished writing result to file\n";
-        };
-
-        std::function<void(std::string)> lz77_10_Decoding = [this, path](std::string fileName) {
-            std::string sourceFile = path + this->cutExtension(fileName) + ".lz7710";
-            Unpacker* unpacker = new Unpacker(sourceFile);
-
-            int dictSize = 8 * 1024;
-            int windowSize = 10 * 1024;
-            LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
-
-            std::vector<LZ77Coder::Triple> unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
-            std::cout << "[LZ77-10] Read packed data\n";
-
-            /// Creating new file with the result of encoding.
-            std::string resultFileName = path + this->cutExtension(fileName) + ".unlz7710";
-            Converter::getInstance().writeCharSequenceToABinaryFile(resultFileName,
-                                                                    coder->encode(unpacked));
-            std::cout << "[LZ77-10] Decoded and made new file with the result\n\n";
-        };
-
-        std::function<void(std::string)> lz77_20_Coding = [this, path](std::string sourceFileName) {
-            std::cout << "[LZ77-20] Preparing packer and getting source\n";
-
-            std::string outputFile = path + this->cutExtension(sourceFileName) + ".lz7720";
-            Packer* packer = new Packer(outputFile);
-            CharSequence data = Converter::getInstance().readBinaryFile(path + sourceFileName);
-
-            int dictSize = 16 * 1024;
-            int windowSize = 20 * 1024;
-            LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
-
-            std::cout << "[LZ77-20] Starting coding\n";
-            std::vector<LZ77Coder::Triple> codedInfo = coder->code(data);
-            std::cout << "[LZ77-20] Have finished coding\n";
-
-            packer->writeTriples(codedInfo, dictSize, windowSize - dictSize);
-            std::cout << "[LZ77-20] Finished writing result to file\n";
-        };
-
-        std::function<void(std::string)> lz77_20_Decoding = [this, path](std::string fileName) {
-            std::string sourceFile = path + this->cutExtension(fileName) + ".lz7720";
-            Unpacker* unpacker = new Unpacker(sourceFile);
-
-            int dictSize = 16 * 1024;
-            int windowSize = 20 * 1024;
-            LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
-
-            std::vector<LZ77Coder::Triple> unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
-            std::cout << "[LZ77-20] Read packed data\n";
-
-            /// Creating new file with the result of encoding.
-            std::string resultFileName = path + this->cutExtension(fileName) + ".unlz7720";
-            Converter::getInstance().writeCharSequenceToABinaryFile(resultFileName,
-                                                                    coder->encode(unpacked));
-            std::cout << "[LZ77-20] Decoded and made new file with the result\n\n";
-        };
-
         std::function<void(std::string)> lzw_coding = [this, path](std::string sourceFileName) {
             std::cout << "[LZW] Preparing packer and getting source\n";
 
@@ -244,13 +130,13 @@ public:
         };
 
         for (const std::string& fileName: files) {
-            std::vector<TestResult> testsResults(5);
+            std::vector<TestResult> testsResults;
 
-            testsResults[0] = launchAlgorithmsTest(fileName, cutExtension(fileName) + ".shan", shannon_fano_coding, shannon_fano_decoding);
-            testsResults[1] = launchAlgorithmsTest(fileName, cutExtension(fileName) + ".lz775", lz77_5_Coding, lz77_5_Decoding);
-            testsResults[2] = launchAlgorithmsTest(fileName, cutExtension(fileName) + ".lz7710", lz77_10_Coding, lz77_10_Decoding);
-            testsResults[3] = launchAlgorithmsTest(fileName, cutExtension(fileName) + ".lz7720", lz77_20_Coding, lz77_20_Decoding);
-            testsResults[4] = launchAlgorithmsTest(fileName, cutExtension(fileName) + ".lzw", lzw_coding, lzw_decoding);
+            testsResults.push_back(launchAlgorithmsTest(fileName, cutExtension(fileName) + ".shan", shannon_fano_coding, shannon_fano_decoding));
+            for (int level = constants::MIN_LEVEL_LZ77; level <= constants::MAX_LEVEL_LZ77; ++level)
+                testsResults.push_back(launchAlgorithmsTest(fileName, cutExtension(fileName) + lz77Extension(level),
+                                                            lz77Coding(path, level), lz77Decoding(path, level)));
+            testsResults.push_back(launchAlgorithmsTest(fileName, cutExtension(fileName) + ".lzw", lzw_coding, lzw_decoding));
 
             std::vector<double> overallResults;
             overallResults.push_back(getFileSizeInKBytes(pathPrefix + fileName));
@@ -359,6 +245,80 @@ private:
     Watch watch;
 
 
+    /**
+     * Makes headings of the overall table: size and entropy of a file, then size, compression ratio,
+     * time of decoding and time of coding for Shannon-Fano, each level of LZ77 and LZW.
+     */
+    static std::vector<std::string> makeOverallHeadings() {
+        std::vector<std::string> algorithms{"SF"};
+        for (int level = constants::MIN_LEVEL_LZ77; level <= constants::MAX_LEVEL_LZ77; ++level)
+            algorithms.push_back("LZ77_L" + std::to_string(level));
+        algorithms.push_back("LZW");
+
+        std::vector<std::string> headings{"S1", "H"};
+        for (const std::string& algorithm: algorithms) {
+            for (const char* column: {"_S2", "_K", "_TU", "_TP"})
+                headings.push_back(algorithm + column);
+        }
+
+        return headings;
+    }
+
+
+    std::string lz77Extension(int level) const {
+        return ".lz77l" + std::to_string(level);
+    }
+
+
+    /**
+     * Returns a procedure, which codes a file with LZ77 of given compression level and writes the result.
+     */
+    std::function<void(std::string)> lz77Coding(const std::string& path, int level) {
+        return [this, path, level](std::string sourceFileName) {
+            std::string name = "[LZ77-L" + std::to_string(level) + "] ";
+            std::cout << name << "Preparing packer and getting source\n";
+
+            std::string outputFile = path + this->cutExtension(sourceFileName) + lz77Extension(level);
+            Packer* packer = new Packer(outputFile);
+            CharSequence data = Converter::getInstance().readBinaryFile(path + sourceFileName);
+
+            LZ77Coder* coder = new LZ77Coder(LZ77Coder::level(level));
+
+            std::cout << name << "Starting coding\n";
+            LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+            std::cout << name << "Have finished coding\n";
+
+            packer->writeTriples(codedInfo, *coder);
+            std::cout << name << "Finished writing result to file\n";
+        };
+    }
+
+
+    /**
+     * Returns a procedure, which reads the result of `lz77Coding` with given level and decodes it.
+     * Parameters of the coder are read from the header of the result.
+     */
+    std::function<void(std::string)> lz77Decoding(const std::string& path, int level) {
+        return [this, path, level](std::string fileName) {
+            std::string name = "[LZ77-L" + std::to_string(level) + "] ";
+            std::string sourceFile = path + this->cutExtension(fileName) + lz77Extension(level);
+            Unpacker* unpacker = new Unpacker(sourceFile);
+
+            LZ77Coder::StreamHeader header;
+            LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(header);
+            LZ77Coder* coder = new LZ77Coder(header);
+            std::cout << name << "Read packed data\n";
+
+            /// Creating new file with the result of encoding.
+            std::string resultFileName = path + this->cutExtension(fileName) + ".un" +
+                                         lz77Extension(level).substr(1);
+            Converter::getInstance().writeCharSequenceToABinaryFile(resultFileName,
+                                                                    coder->encode(unpacked, header.originalSize));
+            std::cout << name << "Decoded and made new file with the result\n\n";
+        };
+    }
+
+
     /**
      * Run given procedure and measures time while it is running.
      * @param Procedure to be launched.
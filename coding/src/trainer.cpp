@@ -0,0 +1,42 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include "common/Converter.cpp"
+#include "common/DictionaryTrainer.cpp"
+
+
+/**
+ * Builds a preset dictionary for `LZ77Coder` and `LZWCoder` from given samples.
+ * Usage: trainer <dictionary file> <dictionary size> <sample file>...
+ */
+int main(int argc, char* argv[]) {
+    /// The size must be a whole positive number, so `strtol` has to read the whole argument.
+    long dictionarySize = 0;
+    if (argc >= 4) {
+        char* end = nullptr;
+        errno = 0;
+        dictionarySize = std::strtol(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || errno == ERANGE || dictionarySize > INT_MAX)
+            dictionarySize = 0;
+    }
+
+    if (argc < 4 || dictionarySize <= 0) {
+        std::cerr << "Usage: " << argv[0] << " <dictionary file> <dictionary size> <sample file>..." << std::endl;
+        std::cerr << "Dictionary size is a positive number of characters." << std::endl;
+        return 1;
+    }
+
+    std::vector<CharSequence> samples;
+    for (int index = 3; index < argc; ++index)
+        samples.push_back(Converter::getInstance().readBinaryFile(argv[index]));
+
+    DictionaryTrainer trainer;
+    CharSequence dictionary = trainer.train(samples, static_cast<int>(dictionarySize));
+    Converter::getInstance().writeCharSequenceToABinaryFile(argv[1], dictionary);
+
+    std::cout << "Dictionary of " << dictionary.size() << " characters is written to " << argv[1] << std::endl;
+    return 0;
+}
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
+#include <sstream>
 
 #include "coders/ShannonFanoCoder.cpp"
 #include "coders/LZWCoder.cpp"
 #include "coders/LZ77Coder.cpp"
+#include "common/DictionaryTrainer.cpp"
 
 
 /**
@@ -14,7 +16,7 @@ TEST(ShannonFanoCoder, ShannonFano_1) {
 
     ShannonFanoCoder* coder = new ShannonFanoCoder(values, numbersOfEachChar);
     ShannonFanoCoder::Result result = coder->code(CharSequence{'a', 'b', 'f', 'e', 'd', 'd', 'd', 'd', 'c'});
-    std::shared_ptr<ShannonFanoCoder::Node> tree = ShannonFanoCoder::makeTree(result.asMap());
+    ShannonFanoCoder::Tree tree = ShannonFanoCoder::makeTree(result.asMap());
 
     CharSequence codedAnswer{'0', '0', '0', '1', '1', '1', '1', '1', '1', '1', '1', '0', '1', '1', '0', '1', '1', '0', '1', '1', '0', '1', '1', '0', '1', '0'};
     EXPECT_EQ(result.codedData, codedAnswer);
@@ -33,7 +35,7 @@ TEST(ShannonFanoCoder, ShannonFano_2) {
 
     ShannonFanoCoder* coder = new ShannonFanoCoder(source);
     ShannonFanoCoder::Result result = coder->code(source);
-    std::shared_ptr<ShannonFanoCoder::Node> tree = ShannonFanoCoder::makeTree(result.asMap());
+    ShannonFanoCoder::Tree tree = ShannonFanoCoder::makeTree(result.asMap());
 
     CharSequence answer{'a', 'c', 'f', 'e', 'd', 'd', 'd', 'd', 'b'};
     EXPECT_EQ(answer, coder->encode(CharSequence{'0', '0', '0', '1', '1', '1', '1', '1', '1', '1', '1', '0', '1', '1', '0', '1', '1', '0', '1', '1', '0', '1', '1', '0', '1', '0'}, tree));
@@ -46,12 +48,366 @@ TEST(ShannonFanoCoder, ShannonFano_2) {
 TEST(LZ77Coder, LZ77_1) {
     LZ77Coder* coder = new LZ77Coder(4000, 5000);
     CharSequence data{'d', 'd', 'd', 'b', 'c', 'c', 'b', 'a', 'a', '#'};
-    std::vector<LZ77Coder::Triple> codedInfo = coder->code(data);
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
 
     EXPECT_EQ(data, coder->encode(codedInfo));
 }
 
 
+/**
+ * Testing that the hash chain match finder codes data not worse than the search over the whole dictionary.
+ */
+TEST(LZ77Coder, LZ77_2) {
+    std::string testString = "abracadabra, abracadabra! cadabra abra, abracadabra? dabra-cadabra, abracadabra.";
+    CharSequence data(testString.begin(), testString.end());
+
+    LZ77Coder* bruteForceCoder = new LZ77Coder(16, 24, LZ77Coder::Settings(LZ77Coder::BRUTE_FORCE, 0, 0));
+    LZ77Coder* hashChainCoder = new LZ77Coder(16, 24);
+    LZ77Coder::TripleBuffer bruteForceInfo = bruteForceCoder->code(data);
+    LZ77Coder::TripleBuffer hashChainInfo = hashChainCoder->code(data);
+
+    EXPECT_LE(hashChainInfo.size(), bruteForceInfo.size());
+    EXPECT_EQ(data, bruteForceCoder->encode(bruteForceInfo));
+    EXPECT_EQ(data, hashChainCoder->encode(hashChainInfo));
+}
+
+
+/**
+ * Testing lazy evaluation of matches. All triples of the fixed width format have the same size,
+ * so deferring of a match never pays off and the result is the same as with greedy parsing.
+ * In the flagged format a single character is cheaper than a match, so a short match is replaced
+ * by a single character, when a longer match starts right after it.
+ */
+TEST(LZ77Coder, LZ77_3) {
+    std::string testString = "abcabcdabcdeabcdefabcdefg bcdefgh cdefghi abcdefghij abcdefghijk";
+    CharSequence data(testString.begin(), testString.end());
+
+    LZ77Coder* greedyCoder = new LZ77Coder(32, 48);
+    LZ77Coder* lazyCoder = new LZ77Coder(32, 48, LZ77Coder::Settings(LZ77Coder::HASH_CHAIN, 16, 32, 2));
+    LZ77Coder::TripleBuffer greedyInfo = greedyCoder->code(data);
+    LZ77Coder::TripleBuffer lazyInfo = lazyCoder->code(data);
+
+    EXPECT_EQ(data, lazyCoder->encode(lazyInfo));
+    EXPECT_EQ(greedyInfo.size(), lazyInfo.size());
+
+    /// At the last "abcd" the greedy match is "abcd", but "bcdefghijklmn" starts one character later.
+    std::string flaggedString = "abcd bcdefghijklmn abcdefghijklmn";
+    CharSequence flaggedData(flaggedString.begin(), flaggedString.end());
+
+    LZ77Coder::Settings greedySettings(LZ77Coder::HASH_CHAIN, 16, 32);
+    LZ77Coder::Settings lazySettings(LZ77Coder::HASH_CHAIN, 16, 32, 2);
+    greedySettings.format = lazySettings.format = LZ77Coder::FLAGGED;
+
+    LZ77Coder* flaggedGreedyCoder = new LZ77Coder(64, 96, greedySettings);
+    LZ77Coder* flaggedLazyCoder = new LZ77Coder(64, 96, lazySettings);
+    LZ77Coder::TripleBuffer flaggedGreedyInfo = flaggedGreedyCoder->code(flaggedData);
+    LZ77Coder::TripleBuffer flaggedLazyInfo = flaggedLazyCoder->code(flaggedData);
+    EXPECT_EQ(flaggedData, flaggedLazyCoder->encode(flaggedLazyInfo));
+
+    /// Triples with matches are the only ones, which take more than a flag and a character.
+    auto numberOfMatches = [](const LZ77Coder::TripleBuffer& triples) {
+        int number = 0;
+        for (const LZ77Coder::Triple& triple: triples)
+            number += triple.length > 0 ? 1 : 0;
+        return number;
+    };
+    EXPECT_LE(flaggedLazyInfo.size(), flaggedGreedyInfo.size());
+    EXPECT_LT(numberOfMatches(flaggedLazyInfo), numberOfMatches(flaggedGreedyInfo));
+}
+
+
+/**
+ * Testing optimal parsing, which chooses triples with dynamic programming over their sizes.
+ */
+TEST(LZ77Coder, LZ77_4) {
+    std::string testString = "she sells sea shells on the sea shore, the shells she sells are sea shells for sure";
+    CharSequence data(testString.begin(), testString.end());
+
+    LZ77Coder* greedyCoder = new LZ77Coder(64, 80, LZ77Coder::Settings(LZ77Coder::HASH_CHAIN, 1, 8));
+    LZ77Coder* optimalCoder = new LZ77Coder(64, 80, LZ77Coder::Settings(LZ77Coder::HASH_CHAIN, 1, 8, 0, true));
+    LZ77Coder::TripleBuffer greedyInfo = greedyCoder->code(data);
+    LZ77Coder::TripleBuffer optimalInfo = optimalCoder->code(data);
+
+    EXPECT_EQ(data, optimalCoder->encode(optimalInfo));
+    EXPECT_LE(optimalInfo.size(), greedyInfo.size());
+}
+
+
+/**
+ * Testing encoding of matches, which overlap themselves or are longer than one copy of the decoder.
+ */
+TEST(LZ77Coder, LZ77_5) {
+    std::vector<LZ77Coder::Triple> triples{LZ77Coder::Triple(0, 0, 'a'), LZ77Coder::Triple(1, 40, 'b'),
+                                           LZ77Coder::Triple(3, 7, 'c'), LZ77Coder::Triple(25, 70, 'd'),
+                                           LZ77Coder::Triple(100, 1, 'e')};
+
+    std::string expected = std::string(41, 'a') + "b" + "aabaaba" + "c";
+    for (int index = 0; index < 70; ++index)
+        expected.push_back(expected[expected.size() - 25]);
+    expected += "d";
+    expected += expected[expected.size() - 100];
+    expected += "e";
+
+    LZ77Coder* coder = new LZ77Coder(128, 256);
+    EXPECT_EQ(CharSequence(expected.begin(), expected.end()), coder->encode(triples));
+}
+
+
+/**
+ * Testing the compact buffer of triples, which stores offsets and lengths only for triples with matches.
+ */
+TEST(LZ77Coder, LZ77_6) {
+    std::vector<LZ77Coder::Triple> triples;
+    for (int index = 0; index < 300; ++index)
+        triples.push_back(index % 7 == 3 ? LZ77Coder::Triple(index, index % 50 + 1, 'm') : LZ77Coder::Triple(0, 0, 'c'));
+
+    LZ77Coder::TripleBuffer buffer(triples);
+    EXPECT_EQ(triples.size(), buffer.size());
+
+    size_t index = 0;
+    for (const LZ77Coder::Triple& triple: buffer) {
+        EXPECT_EQ(triples[index].offset, triple.offset);
+        EXPECT_EQ(triples[index].length, buffer[index].length);
+        EXPECT_EQ(triples[index].character, buffer[index].character);
+        index++;
+    }
+    EXPECT_EQ(triples.size(), index);
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+}
+
+
+/**
+ * Testing kernels, which count equal characters of two sequences, against comparing character by character.
+ */
+TEST(LZ77Coder, LZ77_7) {
+    CharSequence first(300, 'a'), second(300, 'a');
+    for (int mismatch = 0; mismatch <= 100; ++mismatch) {
+        second.assign(first.begin(), first.end());
+        second[mismatch] = 'b';
+
+        for (int limit = 0; limit <= 100; limit += 7) {
+            int expected = std::min(mismatch, limit);
+            EXPECT_EQ(expected, MatchLength::compute(first.data(), second.data(), limit));
+            EXPECT_EQ(expected, MatchLength::scalar(first.data(), second.data(), limit));
+#if defined(MATCH_LENGTH_X86)
+            if (__builtin_cpu_supports("sse2"))
+                EXPECT_EQ(expected, MatchLength::sse2(first.data(), second.data(), limit));
+            if (__builtin_cpu_supports("avx2"))
+                EXPECT_EQ(expected, MatchLength::avx2(first.data(), second.data(), limit));
+#endif
+        }
+    }
+}
+
+
+/**
+ * Testing a preset dictionary, which lets short data refer to characters, which are known in advance.
+ */
+TEST(LZ77Coder, LZ77_8) {
+    std::string dictionaryString = "{\"user\": \"\", \"email\": \"@example.com\", \"status\": \"active\"}";
+    std::string testString = "{\"user\": \"finn\", \"email\": \"finn@example.com\", \"status\": \"active\"}";
+    CharSequence dictionary(dictionaryString.begin(), dictionaryString.end());
+    CharSequence data(testString.begin(), testString.end());
+
+    LZ77Coder* plainCoder = new LZ77Coder(1024, 1100);
+    LZ77Coder* presetCoder = new LZ77Coder(1024, 1100);
+    presetCoder->setPresetDictionary(dictionary);
+    EXPECT_EQ(0u, plainCoder->getDictionaryId());
+    EXPECT_NE(0u, presetCoder->getDictionaryId());
+
+    LZ77Coder::TripleBuffer plainInfo = plainCoder->code(data);
+    LZ77Coder::TripleBuffer presetInfo = presetCoder->code(data);
+    EXPECT_LT(presetInfo.size() * 2, plainInfo.size());
+    EXPECT_EQ(data, presetCoder->encode(presetInfo));
+    EXPECT_EQ(data, presetCoder->encode(presetCoder->codeBlocks(data, 20, 1024, 2)));
+
+    std::istringstream input(testString);
+    std::vector<LZ77Coder::Triple> streamed;
+    presetCoder->code(input, [&](const LZ77Coder::Triple& triple) { streamed.push_back(triple); });
+    EXPECT_EQ(presetInfo.size(), streamed.size());
+
+    size_t index = 0;
+    std::ostringstream output;
+    presetCoder->encode([&](LZ77Coder::Triple& triple) {
+        if (index == streamed.size())
+            return false;
+        triple = streamed[index++];
+        return true;
+    }, output);
+    EXPECT_EQ(testString, output.str());
+}
+
+
+/**
+ * Testing long-distance matching, which finds repeats much farther than the dictionary.
+ */
+TEST(LZ77Coder, LZ77_9) {
+    CharSequence repeated(20000), data;
+    unsigned int seed = 2020;
+    for (char& character: repeated) {
+        seed = seed * 1103515245u + 12345u;
+        character = static_cast<char>(seed >> 16);
+    }
+
+    data = repeated;
+    for (int index = 0; index < 100000; ++index) {
+        seed = seed * 1103515245u + 12345u;
+        data.push_back(static_cast<char>(seed >> 16));
+    }
+    utils::append(data, repeated);
+
+    LZ77Coder::Settings settings;
+    settings.format = LZ77Coder::VARIABLE_LENGTH;
+    LZ77Coder* shortCoder = new LZ77Coder(4096, 4096 + 1024, settings);
+    settings.longDistanceBits = 16;
+    LZ77Coder* longCoder = new LZ77Coder(4096, 4096 + 1024, settings);
+
+    LZ77Coder::TripleBuffer shortInfo = shortCoder->code(data);
+    LZ77Coder::TripleBuffer longInfo = longCoder->code(data);
+
+    EXPECT_LT(longInfo.size() + 19000, shortInfo.size());
+    EXPECT_EQ(data, longCoder->encode(longInfo));
+
+    std::vector<LZ77Coder::Block> blocks = longCoder->codeBlocks(data, 60000, 0, 2);
+    EXPECT_EQ(data, longCoder->encode(blocks));
+
+    /// Streaming encoding keeps only the dictionary, so it rejects long-distance matches instead of reading before it.
+    LZ77Coder::TripleBuffer::Iterator iterator = longInfo.begin();
+    std::ostringstream output;
+    EXPECT_THROW(longCoder->encode([&](LZ77Coder::Triple& triple) {
+        if (!(iterator != longInfo.end()))
+            return false;
+        triple = *iterator;
+        ++iterator;
+        return true;
+    }, output), std::runtime_error);
+
+    /// Offsets of the fixed width format can not be farther than the dictionary, so long-distance matching is off.
+    settings.format = LZ77Coder::FIXED_WIDTH;
+    LZ77Coder* fixedWidthCoder = new LZ77Coder(4096, 4096 + 1024, settings);
+    LZ77Coder::TripleBuffer fixedWidthInfo = fixedWidthCoder->code(data);
+    for (const LZ77Coder::Triple& triple: fixedWidthInfo)
+        EXPECT_LE(triple.offset, 4096);
+    EXPECT_EQ(data, fixedWidthCoder->encode(fixedWidthInfo));
+}
+
+
+/**
+ * Testing compression levels: every level codes data, which can be encoded back, and higher levels code better.
+ */
+TEST(LZ77Coder, LZ77_10) {
+    std::string text = "levels choose the match finder, the search depth, the lazy depth and the window. ";
+    unsigned int seed = 2020;
+    while (text.size() < 60000) {
+        seed = seed * 1103515245u + 12345u;
+        size_t start = text.size() - 1 - (seed >> 16) % std::min<size_t>(text.size(), 50000);
+        text += (seed >> 28) % 2 == 0 ? std::string(1, "etaoin shrdlu"[(seed >> 20) % 13])
+                                      : text.substr(start, 3 + (seed >> 8) % 40);
+    }
+    CharSequence data(text.begin(), text.end());
+
+    std::vector<size_t> sizes;
+    for (int level = constants::MIN_LEVEL_LZ77; level <= constants::MAX_LEVEL_LZ77; ++level) {
+        LZ77Coder* coder = new LZ77Coder(LZ77Coder::level(level));
+        LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+        EXPECT_EQ(data, coder->encode(codedInfo));
+        sizes.push_back(codedInfo.size());
+    }
+
+    EXPECT_LT(sizes.back(), sizes.front());
+}
+
+
+/**
+ * Testing a preset dictionary, which is longer than the look-ahead buffer, so its characters are passed
+ * to the match finder once and the finder is copied for each coded data.
+ */
+TEST(LZ77Coder, LZ77_11) {
+    CharSequence dictionary(3000), data;
+    unsigned int seed = 2020;
+    for (char& character: dictionary) {
+        seed = seed * 1103515245u + 12345u;
+        character = static_cast<char>(seed >> 16);
+    }
+    for (int index = 0; index < 30; ++index) {
+        seed = seed * 1103515245u + 12345u;
+        int start = (seed >> 16) % 2900;
+        data.insert(data.end(), dictionary.begin() + start, dictionary.begin() + start + 100);
+        data.push_back(static_cast<char>(seed >> 8));
+    }
+
+    for (LZ77Coder::MatchFinderType matchFinder: {LZ77Coder::BRUTE_FORCE, LZ77Coder::HASH_CHAIN,
+                                                  LZ77Coder::BINARY_TREE}) {
+        for (int longDistanceBits: {0, 16}) {
+            LZ77Coder::Settings settings(matchFinder, 64, 256);
+            settings.format = LZ77Coder::VARIABLE_LENGTH;
+            settings.longDistanceBits = longDistanceBits;
+            LZ77Coder* plainCoder = new LZ77Coder(4096, 4096 + 256, settings);
+            LZ77Coder* presetCoder = new LZ77Coder(4096, 4096 + 256, settings);
+            presetCoder->setPresetDictionary(dictionary);
+
+            LZ77Coder::TripleBuffer presetInfo = presetCoder->code(data);
+            EXPECT_LT(presetInfo.size() * 4, plainCoder->code(data).size());
+            EXPECT_EQ(presetInfo.size(), presetCoder->code(data).size());
+            EXPECT_EQ(data, presetCoder->encode(presetInfo));
+            EXPECT_EQ(data, presetCoder->encode(presetCoder->codeBlocks(data, 1000, 4096, 2)));
+
+            /// Streaming coding does not use long-distance matching.
+            std::istringstream input(std::string(data.begin(), data.end()));
+            LZ77Coder::TripleBuffer streamed;
+            presetCoder->code(input, [&](const LZ77Coder::Triple& triple) { streamed.push_back(triple); });
+            if (longDistanceBits == 0)
+                EXPECT_EQ(presetInfo.size(), streamed.size());
+            EXPECT_EQ(data, presetCoder->encode(streamed));
+        }
+    }
+}
+
+
+/**
+ * Testing a dictionary, which is trained on samples of short records, as a preset dictionary of LZ77 and LZW.
+ */
+TEST(DictionaryTrainer, DictionaryTrainer_1) {
+    const char* names[] = {"finn", "jake", "marceline", "bubblegum", "bmo", "gunter"};
+    const char* statuses[] = {"active", "blocked", "pending"};
+
+    std::vector<CharSequence> samples;
+    for (int index = 0; index < 60; ++index) {
+        std::string record = std::string("{\"id\": ") + std::to_string(index * 7919 % 1000) + ", \"user\": \"" +
+                             names[index % 6] + "\", \"status\": \"" + statuses[index % 3] +
+                             "\", \"created_at\": \"2020-0" + std::to_string(index % 9 + 1) + "-1" +
+                             std::to_string(index % 10) + "T12:00:00Z\"}";
+        samples.push_back(CharSequence(record.begin(), record.end()));
+    }
+
+    CharSequence dictionary = DictionaryTrainer().train(samples, 512);
+    EXPECT_GT(dictionary.size(), 0u);
+    EXPECT_LE(dictionary.size(), 512u);
+
+    std::string testString = "{\"id\": 1234, \"user\": \"jake\", \"status\": \"pending\", "
+                             "\"created_at\": \"2020-03-14T12:00:00Z\"}";
+    CharSequence data(testString.begin(), testString.end());
+
+    LZ77Coder* plainCoder = new LZ77Coder(1024, 1100);
+    LZ77Coder* presetCoder = new LZ77Coder(1024, 1100);
+    presetCoder->setPresetDictionary(dictionary);
+    LZ77Coder::TripleBuffer presetInfo = presetCoder->code(data);
+
+    EXPECT_LT(presetInfo.size() * 2, plainCoder->code(data).size());
+    EXPECT_EQ(data, presetCoder->encode(presetInfo));
+
+    LZWCoder* plainLZWCoder = new LZWCoder();
+    LZWCoder* presetLZWCoder = new LZWCoder();
+    presetLZWCoder->setPresetDictionary(dictionary);
+    LZWCoder::Result presetResult = presetLZWCoder->code(data);
+
+    EXPECT_LT(presetResult.codes.size(), plainLZWCoder->code(data).codes.size());
+    EXPECT_EQ(data, presetLZWCoder->encode(presetResult));
+}
+
+
 /**
  * Testing coding and encoding with LZW.
  */
@@ -62,4 +418,107 @@ TEST(LZWCoder, LZW_1) {
     LZWCoder::Result result = coder->code(source);
 
     EXPECT_EQ(source, coder->encode(result));
-}
\ No newline at end of file
+}
+
+
+/**
+ * Testing coding and encoding with LZW, when the dictionary grows to hundreds of thousands of words.
+ */
+TEST(LZWCoder, LZW_2) {
+    CharSequence source;
+    unsigned int seed = 2020;
+    for (int index = 0; index < 300000; ++index) {
+        seed = seed * 1103515245u + 12345u;
+        source.push_back(static_cast<char>((seed >> 16) % 7 == 0 ? (seed >> 8) : "abcd"[(seed >> 20) % 4]));
+    }
+
+    LZWCoder* coder = new LZWCoder();
+    LZWCoder::Result result = coder->code(source);
+
+    EXPECT_LT(result.codes.size(), source.size() / 2);
+    EXPECT_EQ(source, coder->encode(result));
+}
+
+
+/**
+ * Testing LZW with a bounded dictionary and each policy of what happens, when it is full.
+ */
+TEST(LZWCoder, LZW_3) {
+    std::string testString = "when the dictionary is full, it is frozen or cleared. ";
+    CharSequence source;
+    unsigned int seed = 2020;
+    for (int part = 0; part < 3; ++part) {
+        for (int index = 0; index < 40000; ++index) {
+            seed = seed * 1103515245u + 12345u;
+            source.push_back(part == 1 ? static_cast<char>(seed >> 16) : testString[(index + part) % testString.size()]);
+        }
+    }
+
+    for (LZWCoder::DictionaryPolicy policy: {LZWCoder::FREEZE, LZWCoder::CLEAR, LZWCoder::MONITOR}) {
+        LZWCoder* coder = new LZWCoder(512, policy);
+        LZWCoder::Result result = coder->code(source);
+
+        EXPECT_LE(*std::max_element(result.codes.begin(), result.codes.end()), 512);
+        long long clearCodes = std::count(result.codes.begin(), result.codes.end(), constants::CLEAR_CODE_LZW);
+        EXPECT_EQ(policy != LZWCoder::FREEZE, clearCodes > 0);
+        EXPECT_EQ(source, coder->encode(result));
+    }
+}
+
+
+/**
+ * Testing encoding with LZW, when codes refer to the word, which is added on the same step.
+ */
+TEST(LZWCoder, LZW_4) {
+    CharSequence source(1000, 'a');
+    source.push_back('b');
+    source.insert(source.end(), 1000, 'b');
+
+    LZWCoder* coder = new LZWCoder();
+    LZWCoder::Result result = coder->code(source);
+
+    EXPECT_LT(result.codes.size(), 100u);
+    EXPECT_EQ(source, coder->encode(result));
+}
+
+
+/**
+ * Testing coding and encoding with LZW by blocks in parallel.
+ */
+TEST(LZWCoder, LZW_5) {
+    std::string testString = "blocks of lzw are coded with their own dictionaries. ";
+    CharSequence source;
+    unsigned int seed = 2020;
+    for (int index = 0; index < 100000; ++index) {
+        seed = seed * 1103515245u + 12345u;
+        source.push_back((seed >> 16) % 5 == 0 ? static_cast<char>(seed >> 8) : testString[index % testString.size()]);
+    }
+
+    LZWCoder* coder = new LZWCoder(4096, LZWCoder::CLEAR);
+    coder->setPresetDictionary(CharSequence(testString.begin(), testString.end()));
+    std::vector<LZWCoder::Block> blocks = coder->codeBlocks(source, 30000, 1);
+    std::vector<LZWCoder::Block> parallelBlocks = coder->codeBlocks(source, 30000, 4);
+
+    ASSERT_EQ(4u, parallelBlocks.size());
+    for (size_t index = 0; index < blocks.size(); ++index) {
+        EXPECT_EQ(blocks[index].size, parallelBlocks[index].size);
+        EXPECT_EQ(blocks[index].codes, parallelBlocks[index].codes);
+    }
+
+    EXPECT_EQ(source, coder->encode(parallelBlocks, 4));
+    EXPECT_EQ(source, coder->encode(blocks, 1));
+}
+
+
+/**
+ * Testing coding and encoding of empty data with LZW.
+ */
+TEST(LZWCoder, LZW_6) {
+    for (bool isAlphabetImplicit: {false, true}) {
+        LZWCoder* coder = new LZWCoder(INT_MAX, LZWCoder::FREEZE, isAlphabetImplicit);
+        LZWCoder::Result result = coder->code(CharSequence{});
+
+        EXPECT_TRUE(result.codes.empty());
+        EXPECT_EQ(CharSequence{}, coder->encode(result));
+    }
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <sstream>
 
 #include "common/Packer.cpp"
 #include "common/Unpacker.cpp"
@@ -48,10 +49,10 @@ TEST(LZ77Packing, LZ77Packing_1) {
 
     LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
     CharSequence data{'s', 's', 's', 'd', 'd', 'd', 'd', '#'};
-    std::vector<LZ77Coder::Triple> codedInfo = coder->code(data);
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
 
     packer->writeTriples(codedInfo, dictSize, windowSize - dictSize);
-    std::vector<LZ77Coder::Triple> unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
 
     EXPECT_EQ(unpacked.size(), codedInfo.size());
     for (int i = 0; i < unpacked.size(); ++i) {
@@ -61,6 +62,421 @@ TEST(LZ77Packing, LZ77Packing_1) {
     }
 }
 
+/**
+ * Testing packing and unpacking the result of coding with LZ77, when the dictionary takes megabytes
+ * and the data is repeated farther than the usual dictionary can see.
+ */
+TEST(LZ77Packing, LZ77Packing_2) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 4 * 1024 * 1024;
+    int windowSize = dictSize + 1024;
+
+    CharSequence data(40 * 1024);
+    unsigned int seed = 2020;
+    for (char& character: data) {
+        seed = seed * 1103515245u + 12345u;
+        character = static_cast<char>(seed >> 24);
+    }
+    data.insert(data.end(), data.begin(), data.end());
+
+    LZ77Coder* coder = new LZ77Coder(dictSize, windowSize, LZ77Coder::Settings(LZ77Coder::BINARY_TREE, 32, 64));
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+    EXPECT_LT(codedInfo.size(), data.size() / 2 + 100);
+
+    packer->writeTriples(codedInfo, dictSize, windowSize - dictSize);
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
+
+    EXPECT_EQ(unpacked.size(), codedInfo.size());
+    EXPECT_EQ(data, coder->encode(unpacked));
+}
+
+/*
+ * Testing packing and unpacking the result of coding with LZ77 by blocks, which are coded in parallel.
+ */
+TEST(LZ77Packing, LZ77Packing_3) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 4096;
+    int windowSize = 5120;
+    int blockSize = 3000;
+
+    CharSequence data(2000);
+    unsigned int seed = 2020;
+    for (char& character: data) {
+        seed = seed * 1103515245u + 12345u;
+        character = static_cast<char>('a' + (seed >> 24) % 4);
+    }
+    for (int copy = 0; copy < 3; ++copy)
+        data.insert(data.end(), data.begin(), data.begin() + 2000);
+
+    LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
+    std::vector<LZ77Coder::Block> blocks = coder->codeBlocks(data, blockSize, dictSize, 4);
+    std::vector<LZ77Coder::Block> sequentialBlocks = coder->codeBlocks(data, blockSize, dictSize, 1);
+    std::vector<LZ77Coder::Block> independentBlocks = coder->codeBlocks(data, blockSize, 0, 4);
+
+    ASSERT_EQ(blocks.size(), sequentialBlocks.size());
+    size_t numberOfTriples = 0;
+    size_t numberOfIndependentTriples = 0;
+    for (size_t index = 0; index < blocks.size(); ++index) {
+        EXPECT_EQ(blocks[index].size, sequentialBlocks[index].size);
+        ASSERT_EQ(blocks[index].triples.size(), sequentialBlocks[index].triples.size());
+        for (size_t triple = 0; triple < blocks[index].triples.size(); ++triple) {
+            EXPECT_EQ(sequentialBlocks[index].triples[triple].offset, blocks[index].triples[triple].offset);
+            EXPECT_EQ(sequentialBlocks[index].triples[triple].length, blocks[index].triples[triple].length);
+            EXPECT_EQ(sequentialBlocks[index].triples[triple].character, blocks[index].triples[triple].character);
+        }
+
+        numberOfTriples += blocks[index].triples.size();
+        numberOfIndependentTriples += independentBlocks[index].triples.size();
+    }
+    EXPECT_LT(numberOfTriples, numberOfIndependentTriples);
+
+    packer->writeBlocks(blocks, dictSize, windowSize - dictSize);
+    std::vector<LZ77Coder::Block> unpacked = unpacker->readBlocks(dictSize, windowSize - dictSize);
+
+    ASSERT_EQ(unpacked.size(), blocks.size());
+    EXPECT_EQ(blockSize, unpacked[0].size);
+    EXPECT_EQ(data, coder->encode(unpacked));
+    EXPECT_EQ(data, coder->encode(independentBlocks));
+}
+
+/*
+ * Testing streaming coding and encoding with LZ77, data is longer than a chunk of the stream.
+ */
+TEST(LZ77Packing, LZ77Packing_4) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 4096;
+    int windowSize = 4096 + 300;
+
+    std::string text;
+    unsigned int seed = 2020;
+    while (text.size() < 3 * constants::STREAM_CHUNK_LZ77) {
+        seed = seed * 1103515245u + 12345u;
+        text += (seed >> 28) % 3 == 0 ? std::string(1, static_cast<char>(seed >> 20)) : text.substr(text.size() / 2, 40);
+    }
+    CharSequence data(text.begin(), text.end());
+
+    LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+
+    std::istringstream input(text);
+    packer->writeTriples(input, *coder, dictSize, windowSize - dictSize);
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
+
+    ASSERT_EQ(codedInfo.size(), unpacked.size());
+    for (size_t index = 0; index < unpacked.size(); ++index) {
+        EXPECT_EQ(codedInfo[index].offset, unpacked[index].offset);
+        EXPECT_EQ(codedInfo[index].length, unpacked[index].length);
+    }
+
+    std::ostringstream output;
+    unpacker->readTriples(output, *coder, dictSize, windowSize - dictSize);
+    EXPECT_EQ(text, output.str());
+
+    LZ77Coder::TripleBuffer corrupted(std::vector<LZ77Coder::Triple>{LZ77Coder::Triple(0, 0, 'a'),
+                                                                     LZ77Coder::Triple(5, 3, 'b')});
+    packer->writeTriples(corrupted, dictSize, windowSize - dictSize);
+    EXPECT_THROW(unpacker->readTriples(output, *coder, dictSize, windowSize - dictSize), std::runtime_error);
+}
+
+/*
+ * Testing packing and unpacking triples in the format with flags, which takes less place for single characters.
+ */
+TEST(LZ77Packing, LZ77Packing_5) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 1024;
+    int windowSize = 1024 + 64;
+
+    std::string text = "a flag tells if a match precedes the character, so single characters take nine bits; ";
+    unsigned int seed = 2020;
+    for (int index = 0; index < 2000; ++index) {
+        seed = seed * 1103515245u + 12345u;
+        text += index % 100 < 20 ? text[index % 87] : static_cast<char>(seed >> 24);
+    }
+    CharSequence data(text.begin(), text.end());
+
+    LZ77Coder* fixedCoder = new LZ77Coder(dictSize, windowSize);
+    packer->writeTriples(fixedCoder->code(data), dictSize, windowSize - dictSize);
+    size_t fixedSize = Converter::getInstance().readBinaryFile(outputFileName).size();
+
+    for (int parsing = 0; parsing < 3; ++parsing) {
+        LZ77Coder::Settings settings(LZ77Coder::HASH_CHAIN, 64, 64, parsing == 1 ? 2 : 0, parsing == 2);
+        settings.format = LZ77Coder::FLAGGED;
+        LZ77Coder* coder = new LZ77Coder(dictSize, windowSize, settings);
+        LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+
+        for (const LZ77Coder::Triple& triple: codedInfo)
+            ASSERT_TRUE(triple.length == 0 || triple.length >= LZ77Coder::minMatchLength(LZ77Coder::FLAGGED));
+
+        packer->writeTriples(codedInfo, dictSize, windowSize - dictSize, LZ77Coder::FLAGGED);
+        EXPECT_LT(Converter::getInstance().readBinaryFile(outputFileName).size(), fixedSize * 2 / 3);
+
+        LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize,
+                                                                 LZ77Coder::FLAGGED);
+        EXPECT_EQ(codedInfo.size(), unpacked.size());
+        EXPECT_EQ(data, coder->encode(unpacked));
+    }
+}
+
+/*
+ * Testing packing and unpacking triples, which offsets and lengths are written with Elias codes.
+ */
+TEST(LZ77Packing, LZ77Packing_6) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 32 * 1024;
+    int windowSize = 32 * 1024 + 1024;
+
+    std::string text = "near and short matches are common, ";
+    unsigned int seed = 2020;
+    while (text.size() < 100000) {
+        seed = seed * 1103515245u + 12345u;
+        size_t start = text.size() - 1 - (seed >> 16) % std::min<size_t>(text.size(), 200);
+        text += (seed >> 28) % 4 == 0 ? std::string(1, static_cast<char>(seed >> 20))
+                                      : text.substr(start, 3 + (seed >> 8) % 8);
+    }
+    CharSequence data(text.begin(), text.end());
+
+    LZ77Coder::Settings settings;
+    settings.format = LZ77Coder::FLAGGED;
+    packer->writeTriples(LZ77Coder(dictSize, windowSize, settings).code(data), dictSize, windowSize - dictSize,
+                         LZ77Coder::FLAGGED);
+    size_t flaggedSize = Converter::getInstance().readBinaryFile(outputFileName).size();
+
+    settings.format = LZ77Coder::VARIABLE_LENGTH;
+    LZ77Coder* coder = new LZ77Coder(dictSize, windowSize, settings);
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+    packer->writeTriples(codedInfo, dictSize, windowSize - dictSize, LZ77Coder::VARIABLE_LENGTH);
+    EXPECT_LT(Converter::getInstance().readBinaryFile(outputFileName).size(), flaggedSize * 4 / 5);
+
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize,
+                                                             LZ77Coder::VARIABLE_LENGTH);
+    EXPECT_EQ(codedInfo.size(), unpacked.size());
+    EXPECT_EQ(data, coder->encode(unpacked));
+
+    std::ostringstream output;
+    unpacker->readTriples(output, *coder, dictSize, windowSize - dictSize, LZ77Coder::VARIABLE_LENGTH);
+    EXPECT_EQ(text, output.str());
+}
+
+/*
+ * Testing packing and unpacking triples, which characters, lengths and offsets are coded with Shannon-Fano codes.
+ */
+TEST(LZ77Packing, LZ77Packing_7) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 32 * 1024;
+    int windowSize = 32 * 1024 + 1024;
+
+    std::string text = "characters, lengths and offsets are coded separately. ";
+    unsigned int seed = 2020;
+    while (text.size() < 100000) {
+        seed = seed * 1103515245u + 12345u;
+        size_t start = text.size() - 1 - (seed >> 16) % std::min<size_t>(text.size(), 5000);
+        text += (seed >> 28) % 2 == 0 ? std::string(1, "etaoin shrdlu"[(seed >> 20) % 13])
+                                      : text.substr(start, 3 + (seed >> 8) % 30);
+    }
+    CharSequence data(text.begin(), text.end());
+
+    LZ77Coder::Settings settings;
+    settings.format = LZ77Coder::VARIABLE_LENGTH;
+    packer->writeTriples(LZ77Coder(dictSize, windowSize, settings).code(data), dictSize, windowSize - dictSize,
+                         LZ77Coder::VARIABLE_LENGTH);
+    size_t variableLengthSize = Converter::getInstance().readBinaryFile(outputFileName).size();
+
+    settings.format = LZ77Coder::ENTROPY_CODED;
+    LZ77Coder* coder = new LZ77Coder(dictSize, windowSize, settings);
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+    packer->writeTriples(codedInfo, dictSize, windowSize - dictSize, LZ77Coder::ENTROPY_CODED);
+    EXPECT_LT(Converter::getInstance().readBinaryFile(outputFileName).size(), variableLengthSize * 9 / 10);
+
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize,
+                                                             LZ77Coder::ENTROPY_CODED);
+    EXPECT_EQ(codedInfo.size(), unpacked.size());
+    EXPECT_EQ(data, coder->encode(unpacked));
+
+    std::vector<LZ77Coder::Block> blocks = coder->codeBlocks(data, 30000, dictSize, 2);
+    packer->writeBlocks(blocks, dictSize, windowSize - dictSize, LZ77Coder::ENTROPY_CODED);
+    EXPECT_EQ(data, coder->encode(unpacker->readBlocks(dictSize, windowSize - dictSize, LZ77Coder::ENTROPY_CODED)));
+}
+
+/**
+ * Testing packing and unpacking the result of coding with LZ77 and a preset dictionary together with its ID.
+ */
+TEST(LZ77Packing, LZ77Packing_8) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 4 * 1024;
+    int windowSize = 4 * 1024 + 256;
+
+    std::string dictionaryString = "GET /index.html HTTP/1.1\r\nHost: example.com\r\nAccept: text/html\r\n\r\n";
+    std::string testString = "GET /about.html HTTP/1.1\r\nHost: example.com\r\nAccept: text/html\r\n\r\n";
+    CharSequence data(testString.begin(), testString.end());
+
+    LZ77Coder::Settings settings;
+    settings.format = LZ77Coder::FLAGGED;
+    LZ77Coder* coder = new LZ77Coder(dictSize, windowSize, settings);
+    coder->setPresetDictionary(CharSequence(dictionaryString.begin(), dictionaryString.end()));
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+
+    packer->writeTriples(codedInfo, *coder);
+    LZ77Coder::StreamHeader header;
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(header);
+
+    EXPECT_EQ(coder->getDictionaryId(), header.dictionaryId);
+    EXPECT_EQ(LZ77Coder::FLAGGED, header.format);
+    EXPECT_EQ(codedInfo.size(), unpacked.size());
+
+    LZ77Coder decoder(header, CharSequence(dictionaryString.begin(), dictionaryString.end()));
+    EXPECT_EQ(data, decoder.encode(unpacked, header.originalSize));
+}
+
+/**
+ * Testing packing and unpacking the result of coding with LZ77 with a header, which describes the coder,
+ * so the triples are read and encoded without its parameters.
+ */
+TEST(LZ77Packing, LZ77Packing_9) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    std::string testString = "a header tells the dictionary, the buffer, the format and the size of the data. ";
+    CharSequence data;
+    for (int index = 0; index < 20; ++index)
+        data.insert(data.end(), testString.begin(), testString.begin() + 10 + index * 3);
+
+    for (LZ77Coder::TokenFormat format: {LZ77Coder::FIXED_WIDTH, LZ77Coder::FLAGGED, LZ77Coder::VARIABLE_LENGTH,
+                                         LZ77Coder::ENTROPY_CODED}) {
+        LZ77Coder::Level level = LZ77Coder::level(2);
+        level.settings.format = format;
+        LZ77Coder* coder = new LZ77Coder(level);
+        LZ77Coder::TripleBuffer codedInfo = coder->code(data);
+        packer->writeTriples(codedInfo, *coder);
+
+        LZ77Coder::StreamHeader header;
+        LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(header);
+        EXPECT_EQ(level.dictSize, header.dictSize);
+        EXPECT_EQ(level.windowSize, header.windowSize);
+        EXPECT_EQ(format, header.format);
+        EXPECT_EQ(0u, header.dictionaryId);
+        EXPECT_EQ(data.size(), header.originalSize);
+
+        EXPECT_EQ(codedInfo.size(), unpacked.size());
+        EXPECT_EQ(data, LZ77Coder(header).encode(unpacked, header.originalSize));
+    }
+}
+
+/**
+ * Testing that triples with a header are not read from a foreign or truncated file
+ * and are not encoded with another preset dictionary.
+ */
+TEST(LZ77Packing, LZ77Packing_10) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    std::string dictionaryString = "a header keeps the id of the preset dictionary, ";
+    std::string testString = "a header keeps the id of the preset dictionary, so another one is not used.";
+    CharSequence dictionary(dictionaryString.begin(), dictionaryString.end());
+    CharSequence data(testString.begin(), testString.end());
+
+    LZ77Coder* coder = new LZ77Coder(LZ77Coder::level(2));
+    coder->setPresetDictionary(dictionary);
+    packer->writeTriples(coder->code(data), *coder);
+
+    LZ77Coder::StreamHeader header;
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(header);
+    EXPECT_EQ(data, LZ77Coder(header, dictionary).encode(unpacked, header.originalSize));
+    EXPECT_THROW(LZ77Coder coder(header), std::invalid_argument);
+    EXPECT_THROW(LZ77Coder coder(header, data), std::invalid_argument);
+
+    CharSequence packed = Converter::getInstance().readBinaryFile(outputFileName);
+    Converter::getInstance().writeCharSequenceToABinaryFile(outputFileName,
+                                                            CharSequence(packed.begin(), packed.end() - 4));
+    EXPECT_THROW(unpacker->readTriples(header), std::runtime_error);
+
+    Converter::getInstance().writeCharSequenceToABinaryFile(outputFileName, data);
+    EXPECT_THROW(unpacker->readTriples(header), std::runtime_error);
+}
+
+/**
+ * Testing compression levels as they are: higher levels pack smaller, and deferred or optimally parsed matches
+ * of a level pack smaller than greedy parsing with the same search.
+ */
+TEST(LZ77Packing, LZ77Packing_11) {
+    Packer* packer = new Packer(outputFileName);
+
+    std::string text = "levels choose the match finder, the search depth, the lazy depth and the format. ";
+    unsigned int seed = 2020;
+    while (text.size() < 60000) {
+        seed = seed * 1103515245u + 12345u;
+        size_t start = text.size() - 1 - (seed >> 16) % std::min<size_t>(text.size(), 50000);
+        text += (seed >> 28) % 2 == 0 ? std::string(1, "etaoin shrdlu"[(seed >> 20) % 13])
+                                      : text.substr(start, 3 + (seed >> 8) % 40);
+    }
+    CharSequence data(text.begin(), text.end());
+
+    auto packedSize = [&](const LZ77Coder::Level& level) {
+        LZ77Coder coder(level);
+        packer->writeTriples(coder.code(data), coder);
+        return Converter::getInstance().readBinaryFile(outputFileName).size();
+    };
+
+    std::vector<size_t> sizes;
+    for (int number = constants::MIN_LEVEL_LZ77; number <= constants::MAX_LEVEL_LZ77; ++number) {
+        LZ77Coder::Level level = LZ77Coder::level(number);
+        sizes.push_back(packedSize(level));
+
+        if (level.settings.lazyDepth > 0 || level.settings.isOptimalParsing) {
+            level.settings.lazyDepth = 0;
+            level.settings.isOptimalParsing = false;
+            EXPECT_LT(sizes.back(), packedSize(level));
+        }
+    }
+
+    EXPECT_LT(sizes.back(), sizes.front());
+}
+
+/**
+ * Testing packing and unpacking of offsets wider than 32 bits, which long-distance matches of large data have.
+ */
+TEST(LZ77Packing, LZ77Packing_12) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    int dictSize = 4 * 1024;
+    int windowSize = 5 * 1024;
+
+    std::vector<LZ77Coder::Triple> triples{
+            LZ77Coder::Triple(0, 0, 'a'),
+            LZ77Coder::Triple(3LL << 31, 100, 'b'),
+            LZ77Coder::Triple(1, 3, 'c'),
+            LZ77Coder::Triple((1LL << 40) + 12345, 200, 'd'),
+            LZ77Coder::Triple((1LL << 62) - 1, 4, 'e')
+    };
+    LZ77Coder::TripleBuffer codedInfo(triples);
+
+    for (LZ77Coder::TokenFormat format: {LZ77Coder::VARIABLE_LENGTH, LZ77Coder::ENTROPY_CODED}) {
+        packer->writeTriples(codedInfo, dictSize, windowSize - dictSize, format);
+        LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize, format);
+
+        ASSERT_EQ(triples.size(), unpacked.size());
+        for (size_t index = 0; index < triples.size(); ++index) {
+            EXPECT_EQ(triples[index].offset, unpacked[index].offset);
+            EXPECT_EQ(triples[index].length, unpacked[index].length);
+            EXPECT_EQ(triples[index].character, unpacked[index].character);
+        }
+    }
+}
+
 /*
  * Testing packing and unpacking the result of coding with LZW.
  */
@@ -84,3 +500,156 @@ TEST(LZWPacking, LZWPacking_1) {
     ASSERT_TRUE(std::equal(result.dictionary.begin(), result.dictionary.end(), unpackedResult.dictionary.begin(), condition));
 }
 
+
+/**
+ * Testing packing and unpacking LZW codes, which widen together with the dictionary,
+ * also with a preset dictionary, which words are not written.
+ */
+TEST(LZWPacking, LZWPacking_2) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    std::string testString = "codes of lzw widen together with the dictionary, codes of lzw widen with it. ";
+    CharSequence source;
+    for (int index = 0; index < 200; ++index)
+        source.insert(source.end(), testString.begin() + index % 20, testString.end());
+
+    for (bool isPreset: {false, true}) {
+        LZWCoder* coder = new LZWCoder();
+        if (isPreset)
+            coder->setPresetDictionary(CharSequence(testString.begin(), testString.end()));
+
+        LZWCoder::Result result = coder->code(source);
+        packer->writeLZWResult(result);
+        size_t packedSize = Converter::getInstance().readBinaryFile(outputFileName).size();
+        EXPECT_LT(packedSize, result.codes.size() * 2);
+
+        LZWCoder::Result unpackedResult = unpacker->readLZWResult();
+        EXPECT_EQ(result.codes, unpackedResult.codes);
+        EXPECT_EQ(source, coder->encode(unpackedResult));
+    }
+}
+
+
+/**
+ * Testing packing and unpacking LZW codes of a bounded dictionary, which is cleared when it is full.
+ */
+TEST(LZWPacking, LZWPacking_3) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    CharSequence source;
+    unsigned int seed = 2020;
+    for (int index = 0; index < 50000; ++index) {
+        seed = seed * 1103515245u + 12345u;
+        source.push_back("abcdefgh"[(seed >> 16) % 8]);
+    }
+
+    LZWCoder* coder = new LZWCoder(1024, LZWCoder::CLEAR);
+    LZWCoder::Result result = coder->code(source);
+    packer->writeLZWResult(result);
+
+    LZWCoder::Result unpackedResult = unpacker->readLZWResult();
+    EXPECT_EQ(result.codes, unpackedResult.codes);
+    EXPECT_EQ(source, coder->encode(unpackedResult));
+}
+
+
+/**
+ * Testing packing and unpacking LZW codes of a stream, which is longer than a chunk.
+ */
+TEST(LZWPacking, LZWPacking_4) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    std::string testString = "streams are coded by chunks, and words of lzw go on from one chunk to another. ";
+    std::string text;
+    unsigned int seed = 2020;
+    while (text.size() < 3 * constants::STREAM_CHUNK_LZW) {
+        seed = seed * 1103515245u + 12345u;
+        text += (seed >> 28) % 3 == 0 ? std::string(1, static_cast<char>(seed >> 20)) : testString.substr((seed >> 16) % 20);
+    }
+
+    for (LZWCoder::DictionaryPolicy policy: {LZWCoder::FREEZE, LZWCoder::CLEAR}) {
+        LZWCoder* coder = new LZWCoder(4096, policy);
+        coder->setPresetDictionary(CharSequence(testString.begin(), testString.end()));
+
+        std::istringstream input(text);
+        packer->writeLZWResult(input, *coder);
+        EXPECT_LT(Converter::getInstance().readBinaryFile(outputFileName).size(), text.size() / 2);
+
+        std::ostringstream output;
+        unpacker->readLZWResult(output, *coder);
+        EXPECT_EQ(text, output.str());
+    }
+}
+
+
+/**
+ * Testing packing and unpacking LZW codes with the implicit alphabet, which are the same as codes of a stream.
+ */
+TEST(LZWPacking, LZWPacking_5) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    std::string testString = "all characters are in the dictionary from the start, so there is no header. ";
+    std::string text;
+    for (int index = 0; index < 300; ++index)
+        text += testString.substr(index % 30) + static_cast<char>(index);
+    CharSequence source(text.begin(), text.end());
+
+    LZWCoder* coder = new LZWCoder(1024, LZWCoder::CLEAR, true);
+    LZWCoder::Result result = coder->code(source);
+    EXPECT_TRUE(result.dictionary.empty());
+    EXPECT_EQ(source, coder->encode(result));
+
+    std::vector<int> streamed;
+    std::istringstream input(text);
+    coder->code(input, [&](int code) { streamed.push_back(code); });
+    EXPECT_EQ(result.codes, streamed);
+
+    packer->writeLZWCodes(result, *coder);
+    EXPECT_EQ(result.codes, unpacker->readLZWCodes(*coder).codes);
+
+    std::ostringstream output;
+    unpacker->readLZWResult(output, *coder);
+    EXPECT_EQ(text, output.str());
+}
+
+
+/**
+ * Testing packing and unpacking LZW codes by blocks, which are packed and read in parallel.
+ */
+TEST(LZWPacking, LZWPacking_6) {
+    Packer* packer = new Packer(outputFileName);
+    Unpacker* unpacker = new Unpacker(outputFileName);
+
+    std::string testString = "each block of lzw codes is written after its size and number of codes. ";
+    CharSequence source;
+    for (int index = 0; index < 1000; ++index)
+        source.insert(source.end(), testString.begin() + index % 25, testString.end());
+
+    LZWCoder* coder = new LZWCoder(1024, LZWCoder::MONITOR);
+    std::vector<LZWCoder::Block> blocks = coder->codeBlocks(source, 10000);
+    packer->writeLZWBlocks(blocks, *coder, 4);
+
+    for (int threads: {1, 4}) {
+        std::vector<LZWCoder::Block> unpacked = unpacker->readLZWBlocks(*coder, threads);
+        ASSERT_EQ(blocks.size(), unpacked.size());
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            EXPECT_EQ(blocks[index].size, unpacked[index].size);
+            EXPECT_EQ(blocks[index].codes, unpacked[index].codes);
+        }
+
+        EXPECT_EQ(source, coder->encode(unpacked));
+    }
+
+    std::vector<LZWCoder::Block> resized = blocks;
+    resized.back().size++;
+    EXPECT_THROW(coder->encode(resized, 4), std::runtime_error);
+
+    CharSequence packed = Converter::getInstance().readBinaryFile(outputFileName);
+    Converter::getInstance().writeCharSequenceToABinaryFile(outputFileName,
+                                                            CharSequence(packed.begin(), packed.end() - 4));
+    EXPECT_THROW(unpacker->readLZWBlocks(*coder, 4), std::runtime_error);
+}
@@ -16,7 +16,7 @@ const std::string exeFileName = "cat.exe";
 
 
 using ShannonFanoResults = std::pair<ShannonFanoCoder::Result, ShannonFanoCoder::Result>;
-using LZ77Results = std::pair<std::vector<LZ77Coder::Triple>, std::vector<LZ77Coder::Triple>>;
+using LZ77Results = std::pair<LZ77Coder::TripleBuffer, LZ77Coder::TripleBuffer>;
 using LZWResults = std::pair<LZWCoder::Result, LZWCoder::Result>;
 
 
@@ -31,7 +31,7 @@ ShannonFanoResults makeShannonFanoResult(const std::string& sourceName) {
 
     packer->writeShannonFanoResult(result);
     ShannonFanoCoder::Result unpackedResult = unpacker->readShannonFanoResult();
-    std::shared_ptr<ShannonFanoCoder::Node> tree = ShannonFanoCoder::makeTree(unpackedResult.asMap());
+    ShannonFanoCoder::Tree tree = ShannonFanoCoder::makeTree(unpackedResult.asMap());
 
     /// Creating new file with the result of encoding.
     Converter::getInstance().writeCharSequenceToABinaryFile(commonResultsPrefix + "sf+" + sourceName,
@@ -50,10 +50,10 @@ LZ77Results makeLZ77Results(const std::string& sourceName) {
 
     LZ77Coder* coder = new LZ77Coder(dictSize, windowSize);
     CharSequence data = Converter::getInstance().readBinaryFile(commonSourcePrefix + sourceName);
-    std::vector<LZ77Coder::Triple> codedInfo = coder->code(data);
+    LZ77Coder::TripleBuffer codedInfo = coder->code(data);
 
     packer->writeTriples(codedInfo, dictSize, windowSize - dictSize);
-    std::vector<LZ77Coder::Triple> unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
+    LZ77Coder::TripleBuffer unpacked = unpacker->readTriples(dictSize, windowSize - dictSize);
 
     /// Creating new file with the result of encoding.
     Converter::getInstance().writeCharSequenceToABinaryFile(commonResultsPrefix + "lz77+" + sourceName,